@@ -0,0 +1,222 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+// Micro-benchmarks of the battle pathfinder queries which are used by the battle AI for every unit and every candidate move. The results
+// are written in CSV format to the standard output so they can be compared between different versions of the engine. The battle is
+// set up on a generated map, so no game resources are needed.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "army.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_board.h"
+#include "battle_cell.h"
+#include "battle_pathfinding.h"
+#include "battle_troop.h"
+#include "monster.h"
+#include "rand.h"
+#include "world.h"
+
+namespace
+{
+    struct Options
+    {
+        std::string filter;
+        uint64_t minTimeMs{ 200 };
+    };
+
+    struct Query
+    {
+        const char * name;
+        // Runs the query for the given unit and returns the number of performed pathfinder calls.
+        std::function<size_t( Battle::BattlePathfinder & pathfinder, const Battle::Unit & unit, const std::vector<Battle::Position> & positions )> run;
+    };
+
+    // The value is accumulated from the results of queries so that they are not optimized away.
+    size_t resultChecksum = 0;
+
+    std::vector<Query> getQueries()
+    {
+        return { { "Evaluate",
+                   []( Battle::BattlePathfinder & /* pathfinder */, const Battle::Unit & unit, const std::vector<Battle::Position> & /* positions */ ) {
+                       // A new pathfinder has no cached graph, so the graph of available positions is built from scratch.
+                       Battle::BattlePathfinder newPathfinder;
+                       resultChecksum += newPathfinder.getAllAvailableMoves( unit ).size();
+
+                       return size_t{ 1 };
+                   } },
+                 { "GetAllAvailableMoves",
+                   []( Battle::BattlePathfinder & pathfinder, const Battle::Unit & unit, const std::vector<Battle::Position> & /* positions */ ) {
+                       resultChecksum += pathfinder.getAllAvailableMoves( unit ).size();
+
+                       return size_t{ 1 };
+                   } },
+                 { "IsPositionReachable",
+                   []( Battle::BattlePathfinder & pathfinder, const Battle::Unit & unit, const std::vector<Battle::Position> & positions ) {
+                       for ( const Battle::Position & position : positions ) {
+                           resultChecksum += pathfinder.isPositionReachable( unit, position, true ) ? 1 : 0;
+                       }
+
+                       return positions.size();
+                   } },
+                 { "BuildPath", []( Battle::BattlePathfinder & pathfinder, const Battle::Unit & unit, const std::vector<Battle::Position> & positions ) {
+                      for ( const Battle::Position & position : positions ) {
+                          resultChecksum += pathfinder.buildPath( unit, position ).size();
+                      }
+
+                      return positions.size();
+                  } } };
+    }
+
+    // Returns the number of pathfinder calls and the average time of one call in nanoseconds.
+    std::pair<uint64_t, double> measure( const Query & query, const Battle::Unit & unit, const std::vector<Battle::Position> & positions, const uint64_t minTimeMs )
+    {
+        Battle::BattlePathfinder pathfinder;
+
+        // The first call builds the graph of available positions for the unit, so the following calls use the cached one.
+        query.run( pathfinder, unit, positions );
+
+        const auto minTime = std::chrono::milliseconds( minTimeMs );
+        const auto startTime = std::chrono::steady_clock::now();
+
+        uint64_t callCount = 0;
+        std::chrono::steady_clock::duration elapsedTime{ 0 };
+
+        // Queries are executed in batches to reduce the overhead of time measurement.
+        for ( uint64_t batchSize = 1; elapsedTime < minTime; batchSize = std::min<uint64_t>( batchSize * 2, 1024 ) ) {
+            for ( uint64_t i = 0; i < batchSize; ++i ) {
+                callCount += query.run( pathfinder, unit, positions );
+            }
+
+            elapsedTime = std::chrono::steady_clock::now() - startTime;
+        }
+
+        const double elapsedTimeNs = std::chrono::duration<double, std::nano>( elapsedTime ).count();
+
+        return { callCount, elapsedTimeNs / static_cast<double>( callCount ) };
+    }
+
+    // Returns all positions which can be occupied by the given unit, reachable or not.
+    std::vector<Battle::Position> getUnitPositions( const Battle::Unit & unit )
+    {
+        std::vector<Battle::Position> positions;
+
+        for ( int32_t cellIdx = 0; cellIdx < Battle::Board::sizeInCells; ++cellIdx ) {
+            const Battle::Position position = Battle::Position::GetPosition( unit, cellIdx );
+            if ( position.GetHead() != nullptr ) {
+                positions.push_back( position );
+            }
+        }
+
+        return positions;
+    }
+
+    bool parseOptions( const int argc, char ** argv, Options & options )
+    {
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string argument( argv[i] );
+
+            if ( i + 1 >= argc ) {
+                return false;
+            }
+
+            if ( argument == "--filter" ) {
+                options.filter = argv[++i];
+            }
+            else if ( argument == "--min-time" ) {
+                try {
+                    options.minTimeMs = std::stoull( argv[++i] );
+                }
+                catch ( const std::exception & ) {
+                    return false;
+                }
+            }
+            else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    Options options;
+    if ( !parseOptions( argc, argv, options ) ) {
+        std::cerr << "Usage: " << argv[0] << " [--filter <query name part>] [--min-time <minimum time per benchmark in ms>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The same seed is used for all runs so the battlefield and its obstacles do not change between runs.
+    Rand::CurrentThreadRandomDevice().seed( 42 );
+
+    world.generateBattleOnlyMap();
+
+    // Units of the attacking army cover the main kinds of movement: a walking unit, a wide walking unit and a flying unit. The defending army
+    // blocks some of the cells.
+    Army attackingArmy;
+    attackingArmy.JoinTroop( Monster::SWORDSMAN, 10, true );
+    attackingArmy.JoinTroop( Monster::CAVALRY, 10, true );
+    attackingArmy.JoinTroop( Monster::PHOENIX, 10, true );
+
+    Army defendingArmy;
+    defendingArmy.JoinTroop( Monster::PIKEMAN, 10, true );
+    defendingArmy.JoinTroop( Monster::ORC, 10, true );
+    defendingArmy.JoinTroop( Monster::TROLL, 10, true );
+    defendingArmy.JoinTroop( Monster::BOAR, 10, true );
+
+    Rand::DeterministicRandomGenerator randomGenerator( 42 );
+    const Battle::Arena arena( attackingArmy, defendingArmy, 0, false, randomGenerator );
+
+    std::cout << "query,unit,wide,flying,positions,calls,ns_per_call" << std::endl;
+    std::cout << std::fixed << std::setprecision( 1 );
+
+    for ( const Query & query : getQueries() ) {
+        if ( std::string( query.name ).find( options.filter ) == std::string::npos ) {
+            continue;
+        }
+
+        for ( const Battle::Unit * unit : arena.GetForce1() ) {
+            const std::vector<Battle::Position> positions = getUnitPositions( *unit );
+
+            const auto [callCount, timeNs] = measure( query, *unit, positions, options.minTimeMs );
+
+            std::cout << query.name << ',' << unit->GetName() << ',' << ( unit->isWide() ? 1 : 0 ) << ',' << ( unit->isFlying() ? 1 : 0 ) << ','
+                      << positions.size() << ',' << callCount << ',' << timeNs << std::endl;
+        }
+    }
+
+    // The checksum is printed to the standard error stream so it does not break the CSV output.
+    std::cerr << "checksum: " << resultChecksum << std::endl;
+
+    return EXIT_SUCCESS;
+}
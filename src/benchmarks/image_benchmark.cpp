@@ -0,0 +1,261 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+// Micro-benchmarks of the image processing functions which are used for rendering. The results are written in CSV format
+// to the standard output so they can be compared between different versions of the engine.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "palette_expansion.h"
+
+namespace
+{
+    struct ImageSize
+    {
+        const char * name;
+        int32_t width;
+        int32_t height;
+    };
+
+    // Typical sizes of images: a map tile, a hero or monster sprite, a full frame of the original game and a full frame of a modern display.
+    const std::array<ImageSize, 4> imageSizes{ { { "tile", 32, 32 }, { "hero", 64, 96 }, { "original_frame", 640, 480 }, { "full_hd_frame", 1920, 1080 } } };
+
+    struct Options
+    {
+        std::string filter;
+        uint64_t minTimeMs{ 200 };
+    };
+
+    // Each kernel is executed on prepared images. Input images are never modified while output images can be modified in any way.
+    struct BenchmarkImages
+    {
+        fheroes2::Image in;
+        fheroes2::Image out;
+        fheroes2::Image scaledOut;
+        // 32-bit pixels of a screen surface.
+        std::vector<uint32_t> surface;
+        // Regions of the input image of the size of normal font characters placed in rows of text over the output image.
+        std::vector<fheroes2::ImageRegion> glyphRegions;
+    };
+
+    struct Kernel
+    {
+        const char * name;
+        bool isSingleLayerSupported;
+        std::function<void( BenchmarkImages & images )> run;
+    };
+
+    fheroes2::Image createImage( const int32_t width, const int32_t height, const bool isSingleLayer, std::mt19937 & generator )
+    {
+        fheroes2::Image image( width, height );
+        if ( isSingleLayer ) {
+            image._disableTransformLayer();
+        }
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 0, 255 );
+        // Most of sprite pixels are either visible or transparent, a small part of them is used for shadows.
+        std::discrete_distribution<uint32_t> transformDistribution( { 70, 25, 2, 1, 1, 1 } );
+
+        const size_t size = static_cast<size_t>( width ) * height;
+
+        uint8_t * imageLayer = image.image();
+        uint8_t * transformLayer = image.transform();
+
+        for ( size_t i = 0; i < size; ++i ) {
+            imageLayer[i] = static_cast<uint8_t>( colorDistribution( generator ) );
+            transformLayer[i] = isSingleLayer ? 0 : static_cast<uint8_t>( transformDistribution( generator ) );
+        }
+
+        return image;
+    }
+
+    std::vector<fheroes2::ImageRegion> createGlyphRegions( const fheroes2::Image & in, const fheroes2::Image & out )
+    {
+        const int32_t glyphWidth = std::min( 8, in.width() );
+        const int32_t glyphHeight = std::min( 11, in.height() );
+        const int32_t columnCount = in.width() / glyphWidth;
+        const int32_t rowCount = in.height() / glyphHeight;
+
+        std::vector<fheroes2::ImageRegion> regions;
+
+        int32_t glyphId = 0;
+
+        // Characters of neighboring rows of text do not overlap. The last character in a row is partially outside the image.
+        for ( int32_t y = 0; y < out.height(); y += glyphHeight + 2 ) {
+            for ( int32_t x = 0; x < out.width(); x += glyphWidth + 1, ++glyphId ) {
+                const int32_t sourceX = ( glyphId % columnCount ) * glyphWidth;
+                const int32_t sourceY = ( ( glyphId / columnCount ) % rowCount ) * glyphHeight;
+
+                regions.push_back( { { sourceX, sourceY, glyphWidth, glyphHeight }, { x, y } } );
+            }
+        }
+
+        return regions;
+    }
+
+    std::vector<Kernel> getKernels()
+    {
+        std::vector<uint8_t> palette( 256 );
+        std::vector<uint32_t> palette32Bit( 256 );
+        for ( size_t i = 0; i < palette.size(); ++i ) {
+            palette[i] = static_cast<uint8_t>( palette.size() - 1 - i );
+            palette32Bit[i] = static_cast<uint32_t>( i * 0x010101 ) | 0xFF000000;
+        }
+
+        fheroes2::PaletteExpander paletteExpander;
+        paletteExpander.setPalette( palette32Bit.data() );
+
+        return { { "Blit", true, []( BenchmarkImages & images ) { fheroes2::Blit( images.in, images.out ); } },
+                 { "BlitFlip", true, []( BenchmarkImages & images ) { fheroes2::Blit( images.in, images.out, true ); } },
+                 { "BlitGlyphs", true,
+                   []( BenchmarkImages & images ) {
+                       // This is how text was rendered before: every character is drawn by a separate call.
+                       for ( const fheroes2::ImageRegion & region : images.glyphRegions ) {
+                           fheroes2::Blit( images.in, region.source.x, region.source.y, images.out, region.position.x, region.position.y, region.source.width,
+                                           region.source.height );
+                       }
+                   } },
+                 { "BlitRegions", true,
+                   []( BenchmarkImages & images ) {
+                       fheroes2::BlitRegions( images.in, images.glyphRegions, images.out, { 0, 0, images.out.width(), images.out.height() } );
+                   } },
+                 { "AlphaBlit", true, []( BenchmarkImages & images ) { fheroes2::AlphaBlit( images.in, images.out, 128 ); } },
+                 { "ApplyPalette", true, [palette]( BenchmarkImages & images ) { fheroes2::ApplyPalette( images.in, images.out, palette ); } },
+                 { "Resize", true, []( BenchmarkImages & images ) { fheroes2::Resize( images.in, images.scaledOut ); } },
+                 { "SubpixelResize", true, []( BenchmarkImages & images ) { fheroes2::SubpixelResize( images.in, images.scaledOut ); } },
+                 { "CreateContour", false, []( BenchmarkImages & images ) { images.out = fheroes2::CreateContour( images.in, 10 ); } },
+                 { "ApplyTransform", true,
+                   []( BenchmarkImages & images ) { fheroes2::ApplyTransform( images.out, 0, 0, images.out.width(), images.out.height(), 2 ); } },
+                 { "ExpandPalette", true, [paletteExpander]( BenchmarkImages & images ) {
+                      paletteExpander.expand( images.in.image(), images.surface.data(), images.surface.size() );
+                  } } };
+    }
+
+    // Returns the number of iterations and the average time of one iteration in nanoseconds.
+    std::pair<uint64_t, double> measure( const Kernel & kernel, BenchmarkImages & images, const uint64_t minTimeMs )
+    {
+        // The first call warms up caches and allocates memory if needed.
+        kernel.run( images );
+
+        const auto minTime = std::chrono::milliseconds( minTimeMs );
+        const auto startTime = std::chrono::steady_clock::now();
+
+        uint64_t iterationCount = 0;
+        std::chrono::steady_clock::duration elapsedTime{ 0 };
+
+        // Kernels are executed in batches to reduce the overhead of time measurement for small images.
+        for ( uint64_t batchSize = 1; elapsedTime < minTime; batchSize = std::min<uint64_t>( batchSize * 2, 1024 ) ) {
+            for ( uint64_t i = 0; i < batchSize; ++i ) {
+                kernel.run( images );
+            }
+
+            iterationCount += batchSize;
+            elapsedTime = std::chrono::steady_clock::now() - startTime;
+        }
+
+        const double elapsedTimeNs = std::chrono::duration<double, std::nano>( elapsedTime ).count();
+
+        return { iterationCount, elapsedTimeNs / static_cast<double>( iterationCount ) };
+    }
+
+    bool parseOptions( const int argc, char ** argv, Options & options )
+    {
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string argument( argv[i] );
+
+            if ( i + 1 >= argc ) {
+                return false;
+            }
+
+            if ( argument == "--filter" ) {
+                options.filter = argv[++i];
+            }
+            else if ( argument == "--min-time" ) {
+                try {
+                    options.minTimeMs = std::stoull( argv[++i] );
+                }
+                catch ( const std::exception & ) {
+                    return false;
+                }
+            }
+            else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    Options options;
+    if ( !parseOptions( argc, argv, options ) ) {
+        std::cerr << "Usage: " << argv[0] << " [--filter <kernel name part>] [--min-time <minimum time per benchmark in ms>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "kernel,image,width,height,layers,iterations,ns_per_call,mpixels_per_s" << std::endl;
+    std::cout << std::fixed << std::setprecision( 1 );
+
+    for ( const Kernel & kernel : getKernels() ) {
+        if ( std::string( kernel.name ).find( options.filter ) == std::string::npos ) {
+            continue;
+        }
+
+        for ( const ImageSize & size : imageSizes ) {
+            for ( const bool isSingleLayer : { true, false } ) {
+                if ( isSingleLayer && !kernel.isSingleLayerSupported ) {
+                    continue;
+                }
+
+                // The same seed is used for all benchmarks so the content of images does not change between runs.
+                std::mt19937 generator( 42 );
+
+                BenchmarkImages images;
+                images.in = createImage( size.width, size.height, isSingleLayer, generator );
+                images.out = createImage( size.width, size.height, isSingleLayer, generator );
+                images.scaledOut = createImage( size.width * 3 / 2, size.height * 3 / 2, isSingleLayer, generator );
+                images.surface.resize( static_cast<size_t>( size.width ) * size.height );
+                images.glyphRegions = createGlyphRegions( images.in, images.out );
+
+                const auto [iterationCount, timeNs] = measure( kernel, images, options.minTimeMs );
+                const double pixelCount = static_cast<double>( size.width ) * size.height;
+
+                std::cout << kernel.name << ',' << size.name << ',' << size.width << ',' << size.height << ',' << ( isSingleLayer ? 1 : 2 ) << ',' << iterationCount
+                          << ',' << timeNs << ',' << pixelCount * 1000 / timeNs << std::endl;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+// Measurements of memory usage and speed of the storage of object parts of map tiles (Maps::Tile keeps them in std::vector, they were kept
+// in std::list before). Tiles of an XL map with object parts are loaded with the engine serializer, copied, scanned and destroyed. Only
+// one type of container is measured by every run of the program, so both types start with the same state of the heap. The results
+// are written in CSV format to the standard output.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __GLIBC__ )
+#include <malloc.h>
+#endif
+
+#include "maps_tiles.h"
+#include "mp2.h"
+#include "serialize.h"
+
+namespace
+{
+    // The number of tiles of an XL map.
+    const size_t tileCount = 144 * 144;
+
+    const int runCount = 300;
+
+    struct PartCount
+    {
+        uint32_t ground{ 0 };
+        uint32_t top{ 0 };
+    };
+
+    struct Distribution
+    {
+        const char * name;
+        std::vector<PartCount> partCounts;
+    };
+
+    // Only object parts of a tile are modelled, the rest of Maps::Tile does not depend on the type of container.
+    template <template <typename...> class Container>
+    struct TileParts
+    {
+        Maps::ObjectPart mainPart;
+        Container<Maps::ObjectPart> groundParts;
+        Container<Maps::ObjectPart> topParts;
+    };
+
+    struct Result
+    {
+        double loadTimeMs{ 0 };
+        double copyTimeMs{ 0 };
+        double scanTimeMs{ 0 };
+        double destroyTimeMs{ 0 };
+    };
+
+    std::vector<Distribution> getDistributions()
+    {
+        std::mt19937 randomGenerator( 7 );
+
+        // Most tiles of real maps have one ground object part or none, and only a few tiles have top object parts.
+        Distribution mixed{ "mixed", std::vector<PartCount>( tileCount ) };
+        for ( PartCount & count : mixed.partCounts ) {
+            const uint32_t groundValue = randomGenerator() % 100;
+            const uint32_t topValue = randomGenerator() % 100;
+
+            count.ground = ( groundValue < 40 ) ? 0 : ( groundValue < 75 ) ? 1 : ( groundValue < 92 ) ? 2 : 3;
+            count.top = ( topValue < 80 ) ? 0 : ( topValue < 95 ) ? 1 : 2;
+        }
+
+        Distribution dense{ "dense", std::vector<PartCount>( tileCount, { 2, 1 } ) };
+
+        return { std::move( mixed ), std::move( dense ) };
+    }
+
+    // Returns the amount of memory allocated on the heap, or 0 if it is not known on this platform.
+    size_t getHeapUsage()
+    {
+#if defined( __GLIBC__ ) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ) )
+        const struct mallinfo2 info = mallinfo2();
+
+        return info.uordblks + info.hblkhd;
+#else
+        return 0;
+#endif
+    }
+
+    double getTimeMs( const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end )
+    {
+        return std::chrono::duration<double, std::milli>( end - start ).count();
+    }
+
+    template <template <typename...> class Container>
+    void measure( const Distribution & distribution, const char * containerName, size_t & checksum )
+    {
+        using Tile = TileParts<Container>;
+
+        const size_t heapUsageAtStart = getHeapUsage();
+
+        std::vector<Tile> tiles( distribution.partCounts.size() );
+
+        const size_t heapUsageOfTiles = getHeapUsage();
+
+        for ( size_t i = 0; i < tiles.size(); ++i ) {
+            const uint32_t uid = static_cast<uint32_t>( i );
+
+            for ( uint32_t part = 0; part < distribution.partCounts[i].ground; ++part ) {
+                tiles[i].groundParts.emplace_back( static_cast<Maps::ObjectLayerType>( part % 4 ), uid + part, MP2::OBJ_ICN_TYPE_TREJNGL, static_cast<uint8_t>( part ) );
+            }
+
+            for ( uint32_t part = 0; part < distribution.partCounts[i].top; ++part ) {
+                tiles[i].topParts.emplace_back( Maps::OBJECT_LAYER, uid + part, MP2::OBJ_ICN_TYPE_OBJNMUL2, static_cast<uint8_t>( part ) );
+            }
+
+            if constexpr ( std::is_same_v<Container<Maps::ObjectPart>, std::vector<Maps::ObjectPart>> ) {
+                // Vectors which are loaded from a save file have exactly the needed capacity.
+                tiles[i].groundParts.shrink_to_fit();
+                tiles[i].topParts.shrink_to_fit();
+            }
+        }
+
+        const size_t heapUsageOfParts = getHeapUsage();
+
+        RWStreamBuf tileStream;
+        for ( const Tile & tile : tiles ) {
+            tileStream << tile.groundParts << tile.topParts;
+        }
+
+        const std::vector<uint8_t> tileData( tileStream.data(), tileStream.data() + tileStream.size() );
+
+        uint32_t groundPartCount = 0;
+        uint32_t topPartCount = 0;
+        for ( const PartCount & count : distribution.partCounts ) {
+            groundPartCount += count.ground;
+            topPartCount += count.top;
+        }
+
+        Result result{ 1e9, 1e9, 1e9, 1e9 };
+
+        for ( int run = 0; run < runCount; ++run ) {
+            ROStreamBuf inputStream( tileData );
+
+            const auto loadStart = std::chrono::steady_clock::now();
+
+            std::vector<Tile> loadedTiles( tiles.size() );
+            for ( Tile & tile : loadedTiles ) {
+                inputStream >> tile.groundParts >> tile.topParts;
+            }
+
+            const auto copyStart = std::chrono::steady_clock::now();
+
+            std::vector<Tile> copiedTiles = loadedTiles;
+
+            const auto scanStart = std::chrono::steady_clock::now();
+
+            for ( const Tile & tile : copiedTiles ) {
+                for ( const Maps::ObjectPart & part : tile.groundParts ) {
+                    checksum += part.isPassabilityTransparent() ? 1 : 0;
+                }
+
+                for ( const Maps::ObjectPart & part : tile.topParts ) {
+                    checksum += part.icnIndex;
+                }
+            }
+
+            const auto destroyStart = std::chrono::steady_clock::now();
+
+            {
+                const std::vector<Tile> destroyedTiles = std::move( copiedTiles );
+            }
+
+            const auto destroyEnd = std::chrono::steady_clock::now();
+
+            result.loadTimeMs = std::min( result.loadTimeMs, getTimeMs( loadStart, copyStart ) );
+            result.copyTimeMs = std::min( result.copyTimeMs, getTimeMs( copyStart, scanStart ) );
+            result.scanTimeMs = std::min( result.scanTimeMs, getTimeMs( scanStart, destroyStart ) );
+            result.destroyTimeMs = std::min( result.destroyTimeMs, getTimeMs( destroyStart, destroyEnd ) );
+        }
+
+        std::cout << distribution.name << ',' << containerName << ',' << groundPartCount << ',' << topPartCount << ','
+                  << ( heapUsageOfTiles - heapUsageAtStart ) / 1024 << ',' << ( heapUsageOfParts - heapUsageOfTiles ) / 1024 << ',' << result.loadTimeMs << ','
+                  << result.copyTimeMs << ',' << result.scanTimeMs << ',' << result.destroyTimeMs << std::endl;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    const std::string containerName = ( argc == 2 ) ? argv[1] : "";
+    if ( containerName != "vector" && containerName != "list" ) {
+        std::cerr << "Usage: " << argv[0] << " vector|list" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    size_t checksum = 0;
+
+    // Times are the minimum of all runs. The heap usage is 0 if it cannot be measured on this platform.
+    std::cout << "distribution,container,ground parts,top parts,tiles KB,parts KB,load ms,copy ms,scan ms,destroy ms" << std::endl;
+    std::cout << std::fixed << std::setprecision( 3 );
+
+    for ( const Distribution & distribution : getDistributions() ) {
+        if ( containerName == "vector" ) {
+            measure<std::vector>( distribution, "vector", checksum );
+        }
+        else {
+            measure<std::list>( distribution, "list", checksum );
+        }
+    }
+
+    // The checksum is printed to the standard error stream so it does not break the CSV output.
+    std::cerr << "checksum: " << checksum << std::endl;
+
+    return EXIT_SUCCESS;
+}
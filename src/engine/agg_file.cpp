@@ -25,10 +25,24 @@
 #include <iterator>
 #include <string>
 
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined( __EMSCRIPTEN__ ) && !defined( TARGET_PS_VITA ) && !defined( TARGET_NINTENDO_SWITCH )
+#define AGG_FILE_POSIX_MEMORY_MAPPING
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace fheroes2
 {
     bool AGGFile::open( const std::string & fileName )
     {
+        _mappedFile.close();
+        _indexChecksum = 0;
+
         if ( !_stream.open( fileName, "rb" ) ) {
             return false;
         }
@@ -58,6 +72,11 @@ namespace fheroes2
 
             const uint32_t fileOffset = fileEntries.getLE32();
             const uint32_t fileSize = fileEntries.getLE32();
+
+            // The file name hash has been already verified so only the location of the file should be added to the checksum.
+            _indexChecksum = ( _indexChecksum << 5 ) + ( _indexChecksum >> 27 ) + calculateAggFilenameHash( name );
+            _indexChecksum = ( _indexChecksum << 5 ) + ( _indexChecksum >> 27 ) + fileOffset;
+            _indexChecksum = ( _indexChecksum << 5 ) + ( _indexChecksum >> 27 ) + fileSize;
             _files.try_emplace( std::move( name ), std::make_pair( fileSize, fileOffset ) );
         }
 
@@ -66,11 +85,25 @@ namespace fheroes2
             return false;
         }
 
-        return !_stream.fail();
+        if ( _stream.fail() ) {
+            return false;
+        }
+
+        if ( _mappedFile.open( fileName ) && _mappedFile.size() != size ) {
+            // The file has been changed after it was opened.
+            _mappedFile.close();
+        }
+
+        return true;
     }
 
     std::vector<uint8_t> AGGFile::read( const std::string & fileName )
     {
+        if ( _mappedFile.isOpen() ) {
+            const AGGFileData data = readData( fileName );
+            return { data.data(), data.data() + data.size() };
+        }
+
         auto it = _files.find( fileName );
         if ( it == _files.end() ) {
             return {};
@@ -85,6 +118,114 @@ namespace fheroes2
         return {};
     }
 
+    AGGFileData AGGFile::readData( const std::string & fileName )
+    {
+        if ( !_mappedFile.isOpen() ) {
+            return AGGFileData( read( fileName ) );
+        }
+
+        auto it = _files.find( fileName );
+        if ( it == _files.end() ) {
+            return {};
+        }
+
+        const auto [fileSize, fileOffset] = it->second;
+        if ( fileSize == 0 || fileOffset >= _mappedFile.size() || fileSize > _mappedFile.size() - fileOffset ) {
+            // The file is empty or it is located outside the AGG file.
+            return {};
+        }
+
+        return { _mappedFile.data() + fileOffset, fileSize };
+    }
+
+    bool MemoryMappedFile::open( const std::string & fileName )
+    {
+        close();
+
+#if defined( _WIN32 )
+        const HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= 0 ) {
+            CloseHandle( file );
+            return false;
+        }
+
+        const HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+        // The mapping object keeps its own reference to the file.
+        CloseHandle( file );
+
+        if ( mapping == nullptr ) {
+            return false;
+        }
+
+        const void * data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( data == nullptr ) {
+            CloseHandle( mapping );
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>( data );
+        _size = static_cast<size_t>( fileSize.QuadPart );
+        _handle = mapping;
+
+        return true;
+#elif defined( AGG_FILE_POSIX_MEMORY_MAPPING )
+        const int fileDescriptor = ::open( fileName.c_str(), O_RDONLY );
+        if ( fileDescriptor < 0 ) {
+            return false;
+        }
+
+        struct stat fileStat;
+        if ( fstat( fileDescriptor, &fileStat ) != 0 || fileStat.st_size <= 0 ) {
+            ::close( fileDescriptor );
+            return false;
+        }
+
+        const size_t fileSize = static_cast<size_t>( fileStat.st_size );
+        void * data = mmap( nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+
+        // The mapping stays valid after the file descriptor is closed.
+        ::close( fileDescriptor );
+
+        if ( data == MAP_FAILED ) {
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>( data );
+        _size = fileSize;
+
+        return true;
+#else
+        // Memory mapping is not supported on this platform.
+        (void)fileName;
+
+        return false;
+#endif
+    }
+
+    void MemoryMappedFile::close()
+    {
+        if ( _data == nullptr ) {
+            return;
+        }
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( _data );
+        CloseHandle( _handle );
+#elif defined( AGG_FILE_POSIX_MEMORY_MAPPING )
+        munmap( const_cast<uint8_t *>( _data ), _size );
+#endif
+
+        _data = nullptr;
+        _size = 0;
+        _handle = nullptr;
+    }
+
     uint32_t calculateAggFilenameHash( const std::string_view str )
     {
         uint32_t hash = 0;
@@ -33,22 +33,140 @@
 
 namespace fheroes2
 {
+    // Content of a file stored in an AGG file. When the AGG file is memory mapped this is a view of the mapped memory,
+    // otherwise the content is read from the AGG file into the internal buffer.
+    class AGGFileData
+    {
+    public:
+        AGGFileData() = default;
+
+        AGGFileData( const uint8_t * data, const size_t size )
+            : _data( data )
+            , _size( size )
+        {
+            // Do nothing.
+        }
+
+        explicit AGGFileData( std::vector<uint8_t> && buf )
+            : _buf( std::move( buf ) )
+            , _data( _buf.data() )
+            , _size( _buf.size() )
+        {
+            // Do nothing.
+        }
+
+        AGGFileData( const AGGFileData & ) = delete;
+
+        // Moving a vector keeps its memory block so the data pointer stays valid.
+        AGGFileData( AGGFileData && ) = default;
+
+        ~AGGFileData() = default;
+
+        AGGFileData & operator=( const AGGFileData & ) = delete;
+        AGGFileData & operator=( AGGFileData && ) = default;
+
+        const uint8_t * data() const
+        {
+            return _data;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+    private:
+        std::vector<uint8_t> _buf;
+
+        const uint8_t * _data{ nullptr };
+        size_t _size{ 0 };
+    };
+
+    // Read-only memory mapping of a whole file. Memory mapping is not supported on some platforms so the caller must be able to read the file
+    // in a different way if the mapping fails.
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile() = default;
+        MemoryMappedFile( const MemoryMappedFile & ) = delete;
+
+        ~MemoryMappedFile()
+        {
+            close();
+        }
+
+        MemoryMappedFile & operator=( const MemoryMappedFile & ) = delete;
+
+        bool open( const std::string & fileName );
+        void close();
+
+        bool isOpen() const
+        {
+            return _data != nullptr;
+        }
+
+        const uint8_t * data() const
+        {
+            return _data;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        const uint8_t * _data{ nullptr };
+        size_t _size{ 0 };
+
+        // Platform-specific handle of the memory mapping.
+        void * _handle{ nullptr };
+    };
+
     class AGGFile
     {
     public:
+        AGGFile() = default;
+        AGGFile( const AGGFile & ) = delete;
+
+        ~AGGFile() = default;
+
+        AGGFile & operator=( const AGGFile & ) = delete;
+
         bool isGood() const
         {
             return !_stream.fail() && !_files.empty();
         }
 
         bool open( const std::string & fileName );
+
+        // Returns a copy of the file content.
         std::vector<uint8_t> read( const std::string & fileName );
 
+        // Returns the file content without copying it if the AGG file is memory mapped. The returned data is valid as long as this AGG file is open.
+        AGGFileData readData( const std::string & fileName );
+
+        // Returns a checksum of the AGG file index. It changes if any file inside the AGG file is added, removed, moved or resized.
+        uint32_t getIndexChecksum() const
+        {
+            return _indexChecksum;
+        }
+
     private:
         static const size_t _maxFilenameSize = 15; // 8.3 ASCIIZ file name + 2-bytes padding
 
         StreamFile _stream;
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _files;
+
+        // The whole AGG file mapped into memory. It is used instead of the file stream if the platform supports memory mapping.
+        MemoryMappedFile _mappedFile;
+
+        uint32_t _indexChecksum{ 0 };
     };
 
     struct ICNHeader
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -109,4 +110,5 @@ namespace Music
     void setMidiTimidityCfg( const std::string & path );
 
     std::vector<uint8_t> Xmi2Mid( const std::vector<uint8_t> & buf );
+    std::vector<uint8_t> Xmi2Mid( const uint8_t * data, const size_t size );
 }
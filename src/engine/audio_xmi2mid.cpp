@@ -148,8 +148,7 @@ namespace
         uint32_t lengthInBytes{ 0 };
     };
 
-    bool readVariableLengthQuantity( const std::vector<uint8_t>::const_iterator data, const std::vector<uint8_t>::const_iterator dataEnd,
-                                     VariableLengthQuantity & quantity )
+    bool readVariableLengthQuantity( const uint8_t * data, const uint8_t * dataEnd, VariableLengthQuantity & quantity )
     {
         quantity = {};
 
@@ -263,23 +262,23 @@ namespace
         return stream;
     }
 
-    struct VectorSubrange
+    struct DataSubrange
     {
-        std::vector<uint8_t>::const_iterator data;
-        const std::vector<uint8_t>::const_iterator dataEnd;
+        const uint8_t * data;
+        const uint8_t * const dataEnd;
     };
 
     struct XMIData
     {
-        VectorSubrange trackEvents;
+        DataSubrange trackEvents;
 
         bool isValid{ false };
 
-        explicit XMIData( const std::vector<uint8_t> & buf )
-            : trackEvents{ buf.cend(), buf.cend() }
+        XMIData( const uint8_t * data, const size_t size )
+            : trackEvents{ data + size, data + size }
         {
             // Please refer to https://moddingwiki.shikadi.net/wiki/XMI_Format#File_format
-            ROStreamBuf sb( buf );
+            ROStreamBuf sb( data, size );
 
             GroupChunkHeader group;
             sb >> group;
@@ -347,7 +346,7 @@ namespace
             }
 
             // Mark the beginning of the EVNT data.
-            trackEvents.data = buf.cbegin() + static_cast<ptrdiff_t>( sb.tell() );
+            trackEvents.data = data + sb.tell();
             assert( trackEvents.dataEnd - trackEvents.data == static_cast<ptrdiff_t>( iff.length ) );
 
             isValid = ( trackEvents.data != trackEvents.dataEnd );
@@ -380,7 +379,7 @@ namespace
             // Do nothing.
         }
 
-        MidiChunk( const uint32_t time, const uint8_t meta, const uint8_t subType, const std::vector<uint8_t>::const_iterator iter, const uint8_t metaLength )
+        MidiChunk( const uint32_t time, const uint8_t meta, const uint8_t subType, const uint8_t * iter, const uint8_t metaLength )
             : _time( time )
             , _type( meta )
         {
@@ -427,11 +426,11 @@ namespace
 
         MidiEvents() = default;
 
-        explicit MidiEvents( const VectorSubrange & trackEvents )
+        explicit MidiEvents( const DataSubrange & trackEvents )
         {
             assert( trackEvents.data != trackEvents.dataEnd );
 
-            std::vector<uint8_t>::const_iterator iter = trackEvents.data;
+            const uint8_t * iter = trackEvents.data;
 
             auto checkDataPresence = [this, &trackEvents, &iter]( const int32_t requiredLength ) {
                 assert( requiredLength > 0 );
@@ -615,7 +614,7 @@ namespace
         MidiEvents events;
         IFFChunkHeader mtrk{ Tag::MTRK, 0 };
 
-        explicit MidTrack( const VectorSubrange & trackEvents )
+        explicit MidTrack( const DataSubrange & trackEvents )
             : events( trackEvents )
             , mtrk( Tag::MTRK, static_cast<uint32_t>( events.sizeInBytes() ) )
         {
@@ -639,7 +638,7 @@ namespace
         // MIDI format 0 can contain only one track.
         MidTrack track;
 
-        explicit MidData( const VectorSubrange & trackEvents )
+        explicit MidData( const DataSubrange & trackEvents )
             : track( trackEvents )
         {
             // XMI files play MIDI at a fixed clock rate of 120 Hz
@@ -671,7 +670,12 @@ namespace
 
 std::vector<uint8_t> Music::Xmi2Mid( const std::vector<uint8_t> & buf )
 {
-    const XMIData xmi( buf );
+    return Xmi2Mid( buf.data(), buf.size() );
+}
+
+std::vector<uint8_t> Music::Xmi2Mid( const uint8_t * data, const size_t size )
+{
+    const XMIData xmi( data, size );
     if ( !xmi.isValid ) {
         return {};
     }
@@ -25,6 +25,7 @@
 #include <cstring>
 
 #include "image.h"
+#include "tools.h"
 
 namespace
 {
@@ -42,6 +43,7 @@ namespace fheroes2
     {
         _fileNameAndOffset.clear();
         _fileStream.close();
+        _checksum = 0;
 
         if ( !_fileStream.open( path, "rb" ) ) {
             return false;
@@ -82,6 +84,11 @@ namespace fheroes2
             _fileNameAndOffset.try_emplace( std::move( name ), std::make_pair( offset, size ) );
         }
 
+        _fileStream.seek( 0 );
+
+        const std::vector<uint8_t> data = _fileStream.getRaw( fileSize );
+        _checksum = calculateCRC32( data.data(), data.size() );
+
         return true;
     }
 
@@ -46,12 +46,20 @@ namespace fheroes2
 
         std::set<std::string, std::less<>> getAllFileNames() const;
 
+        // Returns the CRC32 of the whole file. It changes if any file inside the H2D file is changed.
+        uint32_t getChecksum() const
+        {
+            return _checksum;
+        }
+
     private:
         // Relationship between file name in non-capital letters and its offset from the start of the archive.
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _fileNameAndOffset;
 
         // Stream for reading h2d file.
         StreamFile _fileStream;
+
+        uint32_t _checksum{ 0 };
     };
 
     // This class is not designed to be performance optimized as it will be used very rarely and out of game running session.
@@ -21,13 +21,16 @@
 #include "image.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 #include "image_palette.h"
+#include "thread.h"
 
 namespace
 {
@@ -349,50 +352,182 @@ namespace
         static bool isInitialized = false;
         if ( !isInitialized ) {
             isInitialized = true;
-            const uint32_t size = 64 * 64 * 64;
-
-            int32_t r = 0;
-            int32_t g = 0;
-            int32_t b = 0;
 
             const uint8_t * gamePalette = fheroes2::getGamePalette();
 
-            for ( uint32_t id = 0; id < size; ++id ) {
-                r = static_cast<int32_t>( id % 64 );
-                g = static_cast<int32_t>( id >> 6 ) % 64;
-                b = static_cast<int32_t>( id >> 12 );
-                int32_t minDistance = INT32_MAX;
-                uint32_t bestPos = 0;
+            // Collect palette colors in the order of the "No cycle" palette. Only the first entry of the same color can be chosen
+            // as the closest one so duplicates are skipped to reduce the number of distance calculations.
+            std::vector<int32_t> paletteRed;
+            std::vector<int32_t> paletteGreen;
+            std::vector<int32_t> paletteBlue;
+            std::vector<uint8_t> paletteId;
 
-                // Use the "No cycle" palette.
-                const uint8_t * correctorX = transformTable + 256 * 15;
+            const uint8_t * correctorX = transformTable + 256 * 15;
 
-                for ( uint32_t i = 0; i < 256; ++i, ++correctorX ) {
-                    const uint8_t * palette = gamePalette + static_cast<ptrdiff_t>( *correctorX ) * 3;
+            for ( uint32_t i = 0; i < 256; ++i, ++correctorX ) {
+                const uint8_t * palette = gamePalette + static_cast<ptrdiff_t>( *correctorX ) * 3;
 
-                    const int32_t sumRed = static_cast<int32_t>( *palette ) + r;
-                    const int32_t offsetRed = static_cast<int32_t>( *palette ) - r;
-                    ++palette;
-                    const int32_t offsetGreen = static_cast<int32_t>( *palette ) - g;
-                    ++palette;
-                    const int32_t offsetBlue = static_cast<int32_t>( *palette ) - b;
-                    ++palette;
-                    // Based on "Redmean" color distance calculation (https://www.compuphase.com/cmetric.htm).
-                    const int32_t distance = ( 2 * 2 * 256 + sumRed ) * offsetRed * offsetRed + 4 * 2 * 256 * offsetGreen * offsetGreen
-                                             + ( 2 * ( 2 * 256 + 255 ) - sumRed ) * offsetBlue * offsetBlue;
-                    if ( minDistance > distance ) {
-                        minDistance = distance;
-                        bestPos = *correctorX;
+                bool isDuplicate = false;
+                for ( size_t j = 0; j < paletteId.size(); ++j ) {
+                    if ( paletteRed[j] == palette[0] && paletteGreen[j] == palette[1] && paletteBlue[j] == palette[2] ) {
+                        isDuplicate = true;
+                        break;
                     }
                 }
 
-                rgbToId[id] = static_cast<uint8_t>( bestPos ); // it's safe to cast
+                if ( !isDuplicate ) {
+                    paletteRed.push_back( palette[0] );
+                    paletteGreen.push_back( palette[1] );
+                    paletteBlue.push_back( palette[2] );
+                    paletteId.push_back( *correctorX );
+                }
             }
+
+            const size_t paletteSize = paletteId.size();
+
+            // Every red component value is processed independently.
+            MultiThreading::parallelFor( 64, MultiThreading::getMaxParallelThreads(), [&]( const size_t redId, const uint32_t /* threadId */ ) {
+                const int32_t r = static_cast<int32_t>( redId );
+
+                // Based on "Redmean" color distance calculation (https://www.compuphase.com/cmetric.htm).
+                // Parts of the distance which do not depend on green and blue components are calculated only once.
+                std::vector<int32_t> redDistance( paletteSize );
+                std::vector<int32_t> blueWeight( paletteSize );
+                std::vector<int32_t> redGreenDistance( paletteSize );
+                std::vector<int32_t> distance( paletteSize );
+
+                for ( size_t i = 0; i < paletteSize; ++i ) {
+                    const int32_t sumRed = paletteRed[i] + r;
+                    const int32_t offsetRed = paletteRed[i] - r;
+
+                    redDistance[i] = ( 2 * 2 * 256 + sumRed ) * offsetRed * offsetRed;
+                    blueWeight[i] = 2 * ( 2 * 256 + 255 ) - sumRed;
+                }
+
+                for ( int32_t g = 0; g < 64; ++g ) {
+                    for ( size_t i = 0; i < paletteSize; ++i ) {
+                        const int32_t offsetGreen = paletteGreen[i] - g;
+                        redGreenDistance[i] = redDistance[i] + 4 * 2 * 256 * offsetGreen * offsetGreen;
+                    }
+
+                    for ( int32_t b = 0; b < 64; ++b ) {
+                        // The loop has no dependency between iterations except the minimum so it can be vectorized by the compiler.
+                        int32_t minDistance = INT32_MAX;
+
+                        for ( size_t i = 0; i < paletteSize; ++i ) {
+                            const int32_t offsetBlue = paletteBlue[i] - b;
+                            distance[i] = redGreenDistance[i] + blueWeight[i] * offsetBlue * offsetBlue;
+                            minDistance = std::min( minDistance, distance[i] );
+                        }
+
+                        // The first palette entry with the minimum distance is the closest color.
+                        size_t bestPos = 0;
+                        while ( distance[bestPos] != minDistance ) {
+                            ++bestPos;
+                        }
+
+                        rgbToId[r + g * 64 + b * 64 * 64] = paletteId[bestPos];
+                    }
+                }
+            } );
         }
 
         return rgbToId[red + green * 64 + blue * 64 * 64];
     }
 
+    // Alpha blending of two palette colors always gives the same color ID for the same alpha value. The results of blending
+    // for all pairs of palette colors are calculated on demand and are kept for a few recently used alpha values.
+    class AlphaBlendCache
+    {
+    public:
+        struct Table
+        {
+            // Alpha values 0 and 255 are never blended so 0 marks an unused table.
+            uint8_t alphaValue{ 0 };
+
+            // The entry at 'inValue * 256 + outValue' contains the stamp in its high byte and the blended color ID in its low byte.
+            // Entries with another stamp were calculated for a previous alpha value or palette and must be calculated again.
+            // This way the table does not need to be cleared every time it is reused.
+            uint8_t stamp{ 0 };
+
+            uint64_t lastUsage{ 0 };
+
+            // The table is allocated when it is used for the first time.
+            std::vector<uint16_t> colorIds;
+        };
+
+        Table & getTable( const uint8_t alphaValue )
+        {
+            const uint8_t * gamePalette = fheroes2::getGamePalette();
+
+            if ( !std::equal( _palette.begin(), _palette.end(), gamePalette ) ) {
+                // All tables are invalid for another palette.
+                std::copy_n( gamePalette, _palette.size(), _palette.begin() );
+
+                for ( Table & table : _tables ) {
+                    table.alphaValue = 0;
+                }
+            }
+
+            ++_usageCounter;
+
+            Table * leastRecentlyUsedTable = &_tables.front();
+
+            for ( Table & table : _tables ) {
+                if ( table.alphaValue == alphaValue ) {
+                    table.lastUsage = _usageCounter;
+                    return table;
+                }
+
+                if ( table.lastUsage < leastRecentlyUsedTable->lastUsage ) {
+                    leastRecentlyUsedTable = &table;
+                }
+            }
+
+            Table & table = *leastRecentlyUsedTable;
+            table.alphaValue = alphaValue;
+            table.lastUsage = _usageCounter;
+
+            if ( table.colorIds.empty() || table.stamp == 255 ) {
+                // The table is cleared only when it is used for the first time or when all stamps have been used.
+                table.colorIds.assign( 256 * 256, 0 );
+                table.stamp = 0;
+            }
+
+            ++table.stamp;
+
+            return table;
+        }
+
+    private:
+        std::array<Table, 4> _tables;
+        std::array<uint8_t, 256 * 3> _palette{};
+        uint64_t _usageCounter{ 0 };
+    };
+
+    uint8_t getAlphaBlendedColorId( AlphaBlendCache::Table & blendTable, const uint8_t inValue, const uint8_t outValue, const uint8_t alphaValue,
+                                    const uint8_t * gamePalette )
+    {
+        uint16_t & entry = blendTable.colorIds[inValue * 256 + outValue];
+        if ( ( entry >> 8 ) == blendTable.stamp ) {
+            return static_cast<uint8_t>( entry );
+        }
+
+        const uint8_t behindValue = 255 - alphaValue;
+
+        const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( inValue ) * 3;
+        const uint8_t * outPAL = gamePalette + static_cast<ptrdiff_t>( outValue ) * 3;
+
+        const uint32_t red = static_cast<uint32_t>( *inPAL ) * alphaValue + static_cast<uint32_t>( *outPAL ) * behindValue;
+        const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
+        const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
+        const uint8_t colorId = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
+
+        entry = static_cast<uint16_t>( ( blendTable.stamp << 8 ) | colorId );
+
+        return colorId;
+    }
+
     void ApplyRawPalette( const fheroes2::Image & in, int32_t inX, int32_t inY, fheroes2::Image & out, int32_t outX, int32_t outY, int32_t width, int32_t height,
                           const uint8_t * palette )
     {
@@ -946,10 +1081,12 @@ namespace fheroes2
         const int32_t widthIn = in.width();
         const int32_t widthOut = out.width();
 
-        const uint8_t behindValue = 255 - alphaValue;
-
         const uint8_t * gamePalette = getGamePalette();
 
+        // Images are usually rendered by the main thread, but the cache is per thread so it is safe to blend images in any thread.
+        thread_local AlphaBlendCache alphaBlendCache;
+        AlphaBlendCache::Table & blendTable = alphaBlendCache.getTable( alphaValue );
+
         if ( flip ) {
             const int32_t offsetInY = inY * widthIn + widthIn - 1 - inX;
             const uint8_t * imageInY = in.image() + offsetInY;
@@ -965,13 +1102,7 @@ namespace fheroes2
                     const uint8_t * imageOutXEnd = imageOutX + width;
 
                     for ( ; imageOutX != imageOutXEnd; --imageInX, ++imageOutX ) {
-                        const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( *imageInX ) * 3;
-                        const uint8_t * outPAL = gamePalette + static_cast<ptrdiff_t>( *imageOutX ) * 3;
-
-                        const uint32_t red = static_cast<uint32_t>( *inPAL ) * alphaValue + static_cast<uint32_t>( *outPAL ) * behindValue;
-                        const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
-                        const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
-                        *imageOutX = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
+                        *imageOutX = getAlphaBlendedColorId( blendTable, *imageInX, *imageOutX, alphaValue, gamePalette );
                     }
                 }
             }
@@ -994,13 +1125,7 @@ namespace fheroes2
                             inValue = *( transformTable + static_cast<ptrdiff_t>( *transformInX ) * 256 + *imageOutX );
                         }
 
-                        const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( inValue ) * 3;
-                        const uint8_t * outPAL = gamePalette + static_cast<ptrdiff_t>( *imageOutX ) * 3;
-
-                        const uint32_t red = static_cast<uint32_t>( *inPAL ) * alphaValue + static_cast<uint32_t>( *outPAL ) * behindValue;
-                        const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
-                        const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
-                        *imageOutX = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
+                        *imageOutX = getAlphaBlendedColorId( blendTable, inValue, *imageOutX, alphaValue, gamePalette );
                     }
                 }
             }
@@ -1019,13 +1144,7 @@ namespace fheroes2
                     const uint8_t * imageInXEnd = imageInX + width;
 
                     for ( ; imageInX != imageInXEnd; ++imageInX, ++imageOutX ) {
-                        const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( *imageInX ) * 3;
-                        const uint8_t * outPAL = gamePalette + static_cast<ptrdiff_t>( *imageOutX ) * 3;
-
-                        const uint32_t red = static_cast<uint32_t>( *inPAL ) * alphaValue + static_cast<uint32_t>( *outPAL ) * behindValue;
-                        const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
-                        const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
-                        *imageOutX = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
+                        *imageOutX = getAlphaBlendedColorId( blendTable, *imageInX, *imageOutX, alphaValue, gamePalette );
                     }
                 }
             }
@@ -1048,13 +1167,7 @@ namespace fheroes2
                             inValue = *( transformTable + static_cast<ptrdiff_t>( *transformInX ) * 256 + *imageOutX );
                         }
 
-                        const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( inValue ) * 3;
-                        const uint8_t * outPAL = gamePalette + static_cast<ptrdiff_t>( *imageOutX ) * 3;
-
-                        const uint32_t red = static_cast<uint32_t>( *inPAL ) * alphaValue + static_cast<uint32_t>( *outPAL ) * behindValue;
-                        const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
-                        const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
-                        *imageOutX = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
+                        *imageOutX = getAlphaBlendedColorId( blendTable, inValue, *imageOutX, alphaValue, gamePalette );
                     }
                 }
             }
@@ -1320,6 +1433,109 @@ namespace fheroes2
         Blit( in, inPos.x, inPos.y, out, outPos.x, outPos.y, size.width, size.height, flip );
     }
 
+    void BlitRegions( const Image & in, const std::vector<ImageRegion> & regions, Image & out, const Rect & outRoi )
+    {
+        if ( in.empty() || out.empty() ) {
+            return;
+        }
+
+        const Rect roi = outRoi ^ Rect( 0, 0, out.width(), out.height() );
+        if ( roi.width <= 0 || roi.height <= 0 ) {
+            return;
+        }
+
+        if ( in.singleLayer() ) {
+            for ( const ImageRegion & region : regions ) {
+                const Rect regionRoi = roi ^ Rect( region.position.x, region.position.y, region.source.width, region.source.height );
+
+                Copy( in, region.source.x + regionRoi.x - region.position.x, region.source.y + regionRoi.y - region.position.y, out, regionRoi.x, regionRoi.y,
+                      regionRoi.width, regionRoi.height );
+            }
+
+            return;
+        }
+
+        const int32_t widthIn = in.width();
+        const int32_t widthOut = out.width();
+
+        const int32_t roiRight = roi.x + roi.width;
+        const int32_t roiBottom = roi.y + roi.height;
+
+        const uint8_t * imageIn = in.image();
+        const uint8_t * transformIn = in.transform();
+        uint8_t * imageOut = out.image();
+        uint8_t * transformOut = out.singleLayer() ? nullptr : out.transform();
+
+        for ( const ImageRegion & region : regions ) {
+            assert( region.source.x >= 0 && region.source.y >= 0 && region.source.x + region.source.width <= widthIn
+                    && region.source.y + region.source.height <= in.height() );
+
+            const int32_t left = std::max( region.position.x, roi.x );
+            const int32_t top = std::max( region.position.y, roi.y );
+            const int32_t right = std::min( region.position.x + region.source.width, roiRight );
+            const int32_t bottom = std::min( region.position.y + region.source.height, roiBottom );
+
+            if ( left >= right || top >= bottom ) {
+                continue;
+            }
+
+            const int32_t width = right - left;
+
+            const int32_t offsetInY = ( region.source.y + top - region.position.y ) * widthIn + region.source.x + left - region.position.x;
+            const uint8_t * imageInY = imageIn + offsetInY;
+            const uint8_t * transformInY = transformIn + offsetInY;
+
+            const int32_t offsetOutY = top * widthOut + left;
+            uint8_t * imageOutY = imageOut + offsetOutY;
+            const uint8_t * imageOutYEnd = imageOutY + ( bottom - top ) * widthOut;
+
+            if ( transformOut == nullptr ) {
+                for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
+                    const uint8_t * imageInX = imageInY;
+                    const uint8_t * transformInX = transformInY;
+                    uint8_t * imageOutX = imageOutY;
+                    const uint8_t * imageInXEnd = imageInX + width;
+
+                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
+                        if ( *transformInX > 0 ) { // apply a transformation
+                            if ( *transformInX != 1 ) { // skip pixel
+                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                            }
+                        }
+                        else { // copy a pixel
+                            *imageOutX = *imageInX;
+                        }
+                    }
+                }
+            }
+            else {
+                uint8_t * transformOutY = transformOut + offsetOutY;
+
+                for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
+                    const uint8_t * imageInX = imageInY;
+                    const uint8_t * transformInX = transformInY;
+                    uint8_t * imageOutX = imageOutY;
+                    uint8_t * transformOutX = transformOutY;
+                    const uint8_t * imageInXEnd = imageInX + width;
+
+                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
+                        if ( *transformInX == 1 ) { // skip pixel
+                            continue;
+                        }
+
+                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
+                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                        }
+                        else { // copy a pixel
+                            *transformOutX = *transformInX;
+                            *imageOutX = *imageInX;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     void Copy( const Image & in, Image & out )
     {
         if ( !out.singleLayer() && !in.singleLayer() ) {
@@ -241,6 +241,17 @@ namespace fheroes2
     // inPos must contain non-negative values
     void Blit( const Image & in, const Point & inPos, Image & out, const Point & outPos, const Size & size, bool flip = false );
 
+    // A part of an image which is drawn at the given position of another image.
+    struct ImageRegion
+    {
+        Rect source;
+        Point position;
+    };
+
+    // Draws the given regions of the image in their order. The result is the same as calling Blit() for each region clipped by outRoi
+    // but the ROI is clipped only once and there is no per-call overhead which matters for a lot of small regions like text characters.
+    void BlitRegions( const Image & in, const std::vector<ImageRegion> & regions, Image & out, const Rect & outRoi );
+
     void Copy( const Image & in, Image & out );
     void Copy( const Image & in, int32_t inX, int32_t inY, Image & out, const Rect & outRoi );
     void Copy( const Image & in, int32_t inX, int32_t inY, Image & out, int32_t outX, int32_t outY, int32_t width, int32_t height );
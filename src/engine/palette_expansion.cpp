@@ -0,0 +1,232 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "palette_expansion.h"
+
+#include <algorithm>
+#include <array>
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#define PALETTE_EXPANSION_AVX2
+
+#include <immintrin.h>
+
+// Managing compiler warnings for SDL headers
+#if defined( __GNUC__ )
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+
+#include <SDL_cpuinfo.h>
+
+// Managing compiler warnings for SDL headers
+#if defined( __GNUC__ )
+#pragma GCC diagnostic pop
+#endif
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+// NEON instructions are always available on 64-bit ARM CPUs so no runtime detection is needed.
+#define PALETTE_EXPANSION_NEON
+
+#include <arm_neon.h>
+#endif
+
+#include "logging.h"
+
+namespace
+{
+    using ExpansionFunction = void ( * )( const uint8_t * in, uint32_t * out, const size_t count, const uint32_t * palette, const uint8_t * colorBytes );
+
+    void splitColorBytes( const uint32_t * palette, uint8_t * colorBytes )
+    {
+        for ( size_t i = 0; i < 256; ++i ) {
+            const uint32_t color = palette[i];
+
+            colorBytes[i] = static_cast<uint8_t>( color );
+            colorBytes[256 + i] = static_cast<uint8_t>( color >> 8 );
+            colorBytes[512 + i] = static_cast<uint8_t>( color >> 16 );
+            colorBytes[768 + i] = static_cast<uint8_t>( color >> 24 );
+        }
+    }
+
+    void expandPaletteScalar( const uint8_t * in, uint32_t * out, const size_t count, const uint32_t * palette )
+    {
+        const uint8_t * inEnd = in + count;
+
+        // Independent lookups are grouped together to let the CPU execute them in parallel.
+        for ( ; in + 4 <= inEnd; in += 4, out += 4 ) {
+            out[0] = palette[in[0]];
+            out[1] = palette[in[1]];
+            out[2] = palette[in[2]];
+            out[3] = palette[in[3]];
+        }
+
+        for ( ; in != inEnd; ++in, ++out ) {
+            *out = palette[*in];
+        }
+    }
+
+#if defined( PALETTE_EXPANSION_AVX2 )
+#if defined( __GNUC__ )
+    __attribute__( ( target( "avx2" ) ) )
+#endif
+    void expandPaletteAVX2( const uint8_t * in, uint32_t * out, const size_t count, const uint32_t * palette, const uint8_t * /* colorBytes */ )
+    {
+        const int * paletteIn = reinterpret_cast<const int *>( palette );
+        const uint8_t * inEnd = in + count;
+
+        // Every 16 indexes are extended to 32-bit values and used to gather colors from the palette.
+        for ( ; in + 16 <= inEnd; in += 16, out += 16 ) {
+            const __m128i indexes = _mm_loadu_si128( reinterpret_cast<const __m128i *>( in ) );
+
+            const __m256i colorsLow = _mm256_i32gather_epi32( paletteIn, _mm256_cvtepu8_epi32( indexes ), 4 );
+            const __m256i colorsHigh = _mm256_i32gather_epi32( paletteIn, _mm256_cvtepu8_epi32( _mm_srli_si128( indexes, 8 ) ), 4 );
+
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), colorsLow );
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( out + 8 ), colorsHigh );
+        }
+
+        expandPaletteScalar( in, out, static_cast<size_t>( inEnd - in ), palette );
+    }
+#endif
+
+#if defined( PALETTE_EXPANSION_NEON )
+    void expandPaletteNEON( const uint8_t * in, uint32_t * out, const size_t count, const uint32_t * palette, const uint8_t * colorBytes )
+    {
+        if ( count < 32 ) {
+            // Loading of lookup tables into registers takes more time than the scalar conversion of a few pixels.
+            expandPaletteScalar( in, out, count, palette );
+            return;
+        }
+
+        // NEON table lookups work with tables of up to 64 bytes. Every byte of 32-bit colors is looked up separately in its own
+        // table of 256 bytes which is split into 4 parts. A lookup of an index outside of a part returns 0 so the results
+        // of all 4 parts can be combined by OR operation.
+        std::array<uint8x16x4_t, 16> tables;
+        for ( size_t i = 0; i < tables.size(); ++i ) {
+            const uint8_t * table = colorBytes + i * 64;
+
+            tables[i].val[0] = vld1q_u8( table );
+            tables[i].val[1] = vld1q_u8( table + 16 );
+            tables[i].val[2] = vld1q_u8( table + 32 );
+            tables[i].val[3] = vld1q_u8( table + 48 );
+        }
+
+        const uint8x16_t partSize = vdupq_n_u8( 64 );
+        const uint8_t * inEnd = in + count;
+
+        for ( ; in + 16 <= inEnd; in += 16, out += 16 ) {
+            const uint8x16_t indexes0 = vld1q_u8( in );
+            const uint8x16_t indexes1 = vsubq_u8( indexes0, partSize );
+            const uint8x16_t indexes2 = vsubq_u8( indexes1, partSize );
+            const uint8x16_t indexes3 = vsubq_u8( indexes2, partSize );
+
+            uint8x16x4_t colors;
+
+            for ( size_t byteId = 0; byteId < 4; ++byteId ) {
+                const uint8x16x4_t * byteTables = tables.data() + byteId * 4;
+
+                colors.val[byteId] = vorrq_u8( vorrq_u8( vqtbl4q_u8( byteTables[0], indexes0 ), vqtbl4q_u8( byteTables[1], indexes1 ) ),
+                                               vorrq_u8( vqtbl4q_u8( byteTables[2], indexes2 ), vqtbl4q_u8( byteTables[3], indexes3 ) ) );
+            }
+
+            // Bytes of colors are interleaved back into 32-bit values.
+            vst4q_u8( reinterpret_cast<uint8_t *>( out ), colors );
+        }
+
+        expandPaletteScalar( in, out, static_cast<size_t>( inEnd - in ), palette );
+    }
+#endif
+
+    // Compares the result of the given implementation with the scalar one for all possible indexes and
+    // a number of elements which is not a multiple of a vector size.
+    bool isImplementationValid( const ExpansionFunction function )
+    {
+        std::array<uint32_t, 256> palette;
+        for ( uint32_t i = 0; i < palette.size(); ++i ) {
+            palette[i] = i | ( ( 255 - i ) << 8 ) | ( ( ( i * 7 ) & 0xFF ) << 16 ) | ( ( ( i * 13 + 5 ) & 0xFF ) << 24 );
+        }
+
+        std::array<uint8_t, 256 * 4> colorBytes;
+        splitColorBytes( palette.data(), colorBytes.data() );
+
+        std::array<uint8_t, 256 * 2 + 13> indexes;
+        for ( size_t i = 0; i < indexes.size(); ++i ) {
+            indexes[i] = static_cast<uint8_t>( ( i * 149 ) ^ ( i >> 8 ) );
+        }
+
+        std::array<uint32_t, indexes.size()> expected;
+        std::array<uint32_t, indexes.size()> result;
+
+        // The input is also processed from an unaligned offset.
+        for ( size_t offset = 0; offset < 2; ++offset ) {
+            const size_t count = indexes.size() - offset;
+
+            expandPaletteScalar( indexes.data() + offset, expected.data(), count, palette.data() );
+            function( indexes.data() + offset, result.data(), count, palette.data(), colorBytes.data() );
+
+            if ( !std::equal( expected.begin(), expected.begin() + count, result.begin() ) ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    ExpansionFunction chooseImplementation()
+    {
+#if defined( PALETTE_EXPANSION_AVX2 )
+        if ( SDL_HasAVX2() ) {
+            if ( isImplementationValid( expandPaletteAVX2 ) ) {
+                return expandPaletteAVX2;
+            }
+
+            ERROR_LOG( "AVX2 palette expansion produces wrong results, the scalar implementation is used instead." )
+        }
+#elif defined( PALETTE_EXPANSION_NEON )
+        if ( isImplementationValid( expandPaletteNEON ) ) {
+            return expandPaletteNEON;
+        }
+
+        ERROR_LOG( "NEON palette expansion produces wrong results, the scalar implementation is used instead." )
+#endif
+
+        return []( const uint8_t * in, uint32_t * out, const size_t count, const uint32_t * palette, const uint8_t * /* colorBytes */ ) {
+            expandPaletteScalar( in, out, count, palette );
+        };
+    }
+}
+
+namespace fheroes2
+{
+    void PaletteExpander::setPalette( const uint32_t * palette )
+    {
+        std::copy( palette, palette + _palette.size(), _palette.begin() );
+
+        splitColorBytes( _palette.data(), _colorBytes.data() );
+    }
+
+    void PaletteExpander::expand( const uint8_t * in, uint32_t * out, const size_t count ) const
+    {
+        static const ExpansionFunction expansionFunction = chooseImplementation();
+
+        expansionFunction( in, out, count, _palette.data(), _colorBytes.data() );
+    }
+}
@@ -0,0 +1,45 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace fheroes2
+{
+    // Converts 8-bit palette indexes into 32-bit colors using a palette of 256 colors. The fastest implementation supported by the CPU
+    // is chosen at runtime. All implementations produce exactly the same result. Lookup tables used by some implementations are built
+    // only when the palette is set, so an instance should be kept as long as its palette does not change.
+    class PaletteExpander
+    {
+    public:
+        void setPalette( const uint32_t * palette );
+
+        void expand( const uint8_t * in, uint32_t * out, const size_t count ) const;
+
+    private:
+        std::array<uint32_t, 256> _palette{};
+
+        // Bytes of palette colors grouped by their position within a color: all lowest bytes go first, then all second bytes and so on.
+        std::array<uint8_t, 256 * 4> _colorBytes{};
+    };
+}
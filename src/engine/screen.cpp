@@ -19,8 +19,10 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
@@ -61,6 +63,7 @@
 #include "image_palette.h"
 #include "logging.h"
 #include "math_tools.h"
+#include "palette_expansion.h"
 #include "screen.h"
 #include "system.h"
 
@@ -257,6 +260,55 @@ namespace
         return true;
     }
 
+    int64_t getRectArea( const fheroes2::Rect & roi )
+    {
+        return static_cast<int64_t>( roi.width ) * roi.height;
+    }
+
+    // Merges areas which are cheaper to render as a single rectangle. Every area requires a separate conversion and texture update call
+    // so areas close to each other are merged together as long as their boundary rectangle does not contain too many unchanged pixels.
+    void mergeRenderAreas( std::vector<fheroes2::Rect> & areas )
+    {
+        // Every texture update call has its own overhead so it is not worth to update more areas than this.
+        const size_t maxAreaCount = 4;
+
+        // Merging small areas like mouse cursor and buttons is almost free even if they are not very close to each other.
+        const int64_t minWastedArea = 64 * 64;
+
+        while ( areas.size() > 1 ) {
+            size_t bestFirstId = 0;
+            size_t bestSecondId = 0;
+            int64_t bestWastedArea = 0;
+            int64_t bestUsefulArea = 0;
+            bool isPairFound = false;
+
+            for ( size_t i = 0; i < areas.size(); ++i ) {
+                for ( size_t j = i + 1; j < areas.size(); ++j ) {
+                    const int64_t usefulArea = getRectArea( areas[i] ) + getRectArea( areas[j] );
+                    const int64_t wastedArea = getRectArea( fheroes2::getBoundaryRect( areas[i], areas[j] ) ) - usefulArea;
+
+                    if ( !isPairFound || wastedArea < bestWastedArea ) {
+                        bestFirstId = i;
+                        bestSecondId = j;
+                        bestWastedArea = wastedArea;
+                        bestUsefulArea = usefulArea;
+                        isPairFound = true;
+                    }
+                }
+            }
+
+            assert( isPairFound );
+
+            if ( areas.size() <= maxAreaCount && bestWastedArea > minWastedArea && bestWastedArea > bestUsefulArea / 2 ) {
+                // All remaining areas are too far from each other.
+                break;
+            }
+
+            areas[bestFirstId] = fheroes2::getBoundaryRect( areas[bestFirstId], areas[bestSecondId] );
+            areas.erase( areas.begin() + static_cast<std::ptrdiff_t>( bestSecondId ) );
+        }
+    }
+
     const uint8_t * currentPalette = PALPalette();
 
 // If SDL library is used
@@ -264,7 +316,7 @@ namespace
     class BaseSDLRenderer
     {
     protected:
-        std::vector<uint32_t> _palette32Bit;
+        fheroes2::PaletteExpander _paletteExpander;
         std::vector<SDL_Color> _palette8Bit;
 
         void copyImageToSurface( const fheroes2::Image & image, SDL_Surface * surface, const fheroes2::Rect & roi )
@@ -287,13 +339,7 @@ namespace
 
             if ( fullFrame ) {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * out = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outEnd = out + imageWidth * imageHeight;
-                    const uint8_t * in = imageIn;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; out != outEnd; ++out, ++in )
-                        *out = *( transform + *in );
+                    _paletteExpander.expand( imageIn, static_cast<uint32_t *>( surface->pixels ), static_cast<size_t>( imageWidth ) * imageHeight );
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
                     if ( imageWidth % 4 != 0 ) {
@@ -312,15 +358,9 @@ namespace
                     uint32_t * outY = static_cast<uint32_t *>( surface->pixels );
                     const uint32_t * outYEnd = outY + imageWidth * roi.height;
                     const uint8_t * inY = imageIn + roi.x + roi.y * imageWidth;
-                    const uint32_t * transform = _palette32Bit.data();
 
                     for ( ; outY != outYEnd; outY += imageWidth, inY += imageWidth ) {
-                        uint32_t * outX = outY;
-                        const uint32_t * outXEnd = outX + roi.width;
-                        const uint8_t * inX = inY;
-
-                        for ( ; outX != outXEnd; ++outX, ++inX )
-                            *outX = *( transform + *inX );
+                        _paletteExpander.expand( inY, outY, static_cast<size_t>( roi.width ) );
                     }
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
@@ -343,20 +383,22 @@ namespace
             assert( surface != nullptr );
 
             if ( surface->format->BitsPerPixel == 32 ) {
-                _palette32Bit.resize( 256u );
+                std::array<uint32_t, 256> palette32Bit;
 
                 if ( surface->format->Amask > 0 ) {
                     for ( size_t i = 0; i < 256u; ++i ) {
                         const uint8_t * value = currentPalette + colorIds[i] * 3;
-                        _palette32Bit[i] = SDL_MapRGBA( surface->format, *value, *( value + 1 ), *( value + 2 ), 255 );
+                        palette32Bit[i] = SDL_MapRGBA( surface->format, *value, *( value + 1 ), *( value + 2 ), 255 );
                     }
                 }
                 else {
                     for ( size_t i = 0; i < 256u; ++i ) {
                         const uint8_t * value = currentPalette + colorIds[i] * 3;
-                        _palette32Bit[i] = SDL_MapRGB( surface->format, *value, *( value + 1 ), *( value + 2 ) );
+                        palette32Bit[i] = SDL_MapRGB( surface->format, *value, *( value + 1 ), *( value + 2 ) );
                     }
                 }
+
+                _paletteExpander.setPalette( palette32Bit.data() );
             }
             else if ( surface->format->BitsPerPixel == 8 ) {
                 _palette8Bit.resize( 256 );
@@ -708,9 +750,9 @@ namespace
             return true;
         }
 
-        void render( const fheroes2::Display & display, const fheroes2::Rect & roi ) override
+        void render( const fheroes2::Display & display, const std::vector<fheroes2::Rect> & rois ) override
         {
-            (void)roi;
+            (void)rois;
 
             if ( _texBuffer == nullptr )
                 return;
@@ -1004,7 +1046,7 @@ namespace
             _windowedSize = {};
         }
 
-        void render( const fheroes2::Display & display, const fheroes2::Rect & roi ) override
+        void render( const fheroes2::Display & display, const std::vector<fheroes2::Rect> & rois ) override
         {
             if ( _surface == nullptr ) {
                 return;
@@ -1012,25 +1054,29 @@ namespace
 
             assert( _renderer != nullptr && _texture != nullptr );
 
-            copyImageToSurface( display, _surface, roi );
+            // Every area is converted into the surface and immediately uploaded into the texture
+            // so the same surface memory can be reused for the next area.
+            for ( const fheroes2::Rect & roi : rois ) {
+                copyImageToSurface( display, _surface, roi );
 
-            const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
-            if ( fullFrame ) {
-                const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
+                if ( fullFrame ) {
+                    const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
+                    if ( returnCode < 0 ) {
+                        ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                    }
                 }
-            }
-            else {
-                SDL_Rect area;
-                area.x = roi.x;
-                area.y = roi.y;
-                area.w = roi.width;
-                area.h = roi.height;
+                else {
+                    SDL_Rect area;
+                    area.x = roi.x;
+                    area.y = roi.y;
+                    area.w = roi.width;
+                    area.h = roi.height;
 
-                const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                    const int returnCode = SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
+                    if ( returnCode < 0 ) {
+                        ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                    }
                 }
             }
 
@@ -1347,7 +1393,7 @@ namespace fheroes2
         // deallocate engine resources
         _engine->clear();
 
-        _prevRoi = {};
+        _prevRois.clear();
 
         // allocate engine resources
         if ( !_engine->allocate( info, isFullScreen ) ) {
@@ -1372,7 +1418,18 @@ namespace fheroes2
         if ( !getActiveArea( temp, width(), height() ) )
             return;
 
-        getActiveArea( _prevRoi, width(), height() );
+        std::vector<Rect> currentRois{ temp };
+
+        // Areas rendered previously must be updated as well since they might contain changes made after the previous render call.
+        std::vector<Rect> renderRois;
+        renderRois.reserve( _prevRois.size() + 2 );
+        renderRois.push_back( temp );
+
+        for ( Rect prevRoi : _prevRois ) {
+            if ( getActiveArea( prevRoi, width(), height() ) ) {
+                renderRois.push_back( prevRoi );
+            }
+        }
 
         if ( _cursor->isVisible() && _cursor->isSoftwareEmulation() && !_cursor->_image.empty() ) {
             const Sprite & cursorImage = _cursor->_image;
@@ -1383,12 +1440,14 @@ namespace fheroes2
                 // ROI must include cursor's area as well, otherwise cursor won't be rendered.
                 Rect cursorROI( cursorImage.x(), cursorImage.y(), cursorImage.width(), cursorImage.height() );
                 if ( getActiveArea( cursorROI, width(), height() ) ) {
-                    temp = getBoundaryRect( temp, cursorROI );
+                    currentRois.push_back( cursorROI );
+                    renderRois.push_back( cursorROI );
                 }
             }
 
             // Previous position of cursor must be updated as well to avoid ghost effect.
-            _renderFrame( getBoundaryRect( temp, _prevRoi ) );
+            mergeRenderAreas( renderRois );
+            _renderFrame( renderRois );
 
             if ( _postprocessing ) {
                 _postprocessing();
@@ -1397,22 +1456,28 @@ namespace fheroes2
             Copy( backup, 0, 0, *this, backup.x(), backup.y(), backup.width(), backup.height() );
         }
         else {
-            _renderFrame( getBoundaryRect( temp, _prevRoi ) );
+            mergeRenderAreas( renderRois );
+            _renderFrame( renderRois );
 
             if ( _postprocessing ) {
                 _postprocessing();
             }
         }
 
-        _prevRoi = temp;
+        _prevRois = std::move( currentRois );
     }
 
     void Display::updateNextRenderRoi( const Rect & roi )
     {
-        _prevRoi = getBoundaryRect( _prevRoi, roi );
+        if ( roi.width <= 0 || roi.height <= 0 ) {
+            return;
+        }
+
+        _prevRois.push_back( roi );
+        mergeRenderAreas( _prevRois );
     }
 
-    void Display::_renderFrame( const Rect & roi ) const
+    void Display::_renderFrame( const std::vector<Rect> & rois ) const
     {
         bool updateImage = true;
         if ( _preprocessing ) {
@@ -1423,14 +1488,14 @@ namespace fheroes2
                 updateImage = ( _renderSurface == nullptr );
                 if ( updateImage ) {
                     // Pre-processing step is applied to the whole image so we forcefully render the full frame.
-                    _engine->render( *this, { 0, 0, width(), height() } );
+                    _engine->render( *this, { { 0, 0, width(), height() } } );
                     return;
                 }
             }
         }
 
         if ( updateImage ) {
-            _engine->render( *this, roi );
+            _engine->render( *this, rois );
         }
     }
 
@@ -1450,7 +1515,7 @@ namespace fheroes2
         _cursor.reset();
         clear();
 
-        _prevRoi = {};
+        _prevRois.clear();
     }
 
     void Display::changePalette( const uint8_t * palette, const bool forceDefaultPaletteUpdate ) const
@@ -152,7 +152,8 @@ namespace fheroes2
             // Do nothing.
         }
 
-        virtual void render( const Display &, const Rect & )
+        // Render the given non-empty areas of the display on screen.
+        virtual void render( const Display &, const std::vector<Rect> & )
         {
             // Do nothing.
         }
@@ -254,8 +255,10 @@ namespace fheroes2
 
         uint8_t * _renderSurface;
 
-        // Previous area drawn on the screen.
-        Rect _prevRoi;
+        // Areas drawn on the screen during the previous render call and areas requested to be rendered on the next render call.
+        // They are kept separately instead of being merged into one boundary rectangle so distant small changes
+        // (like mouse cursor and a status bar) do not force the whole frame to be updated.
+        std::vector<Rect> _prevRois;
 
         Size _screenSize;
 
@@ -267,7 +270,7 @@ namespace fheroes2
 
         Display();
 
-        void _renderFrame( const Rect & roi ) const; // prepare and render a frame
+        void _renderFrame( const std::vector<Rect> & rois ) const; // prepare and render a frame
     };
 
     class Cursor
@@ -39,6 +39,13 @@
 #include "tools.h"
 #endif
 
+#if defined( _WIN32 )
+#include <io.h>
+#elif !defined( __EMSCRIPTEN__ ) && !defined( TARGET_PS_VITA ) && !defined( TARGET_NINTENDO_SWITCH )
+#define STREAM_FILE_FSYNC
+#include <unistd.h>
+#endif
+
 #include "logging.h"
 
 namespace
@@ -366,6 +373,16 @@ ROStreamBuf::ROStreamBuf( const std::vector<uint8_t> & buf )
     setBigendian( IS_BIGENDIAN );
 }
 
+ROStreamBuf::ROStreamBuf( const uint8_t * data, const size_t size )
+{
+    _itbeg = data;
+    _itend = _itbeg + size;
+    _itget = _itbeg;
+    _itput = _itend;
+
+    setBigendian( IS_BIGENDIAN );
+}
+
 ROStreamBuf::ROStreamBuf( std::vector<uint8_t> && buf )
     : _buf( std::move( buf ) )
 {
@@ -423,6 +440,35 @@ void StreamFile::close()
     _file.reset();
 }
 
+bool StreamFile::flush()
+{
+    if ( !_file ) {
+        return false;
+    }
+
+    if ( std::fflush( _file.get() ) != 0 ) {
+        setFail();
+
+        return false;
+    }
+
+#if defined( _WIN32 )
+    if ( _commit( _fileno( _file.get() ) ) != 0 ) {
+        setFail();
+
+        return false;
+    }
+#elif defined( STREAM_FILE_FSYNC )
+    if ( fsync( fileno( _file.get() ) ) != 0 ) {
+        setFail();
+
+        return false;
+    }
+#endif
+
+    return true;
+}
+
 size_t StreamFile::size()
 {
     if ( !_file ) {
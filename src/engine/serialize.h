@@ -592,11 +592,14 @@ private:
 };
 
 // Stream with read-only in-memory storage backed by a const vector instance (either internal or external, depending on the constructor used)
+// or by an external memory block
 class ROStreamBuf final : public StreamBufTmpl<const uint8_t>
 {
 public:
     // Creates a non-owning stream on top of an external buffer ("view mode")
     explicit ROStreamBuf( const std::vector<uint8_t> & buf );
+    // Creates a non-owning stream on top of an external memory block ("view mode")
+    ROStreamBuf( const uint8_t * data, const size_t size );
     // Takes ownership of the given buffer (through the move operation) and creates a stream on top of it
     explicit ROStreamBuf( std::vector<uint8_t> && buf );
 
@@ -640,6 +643,9 @@ public:
     bool open( const std::string & fn, const std::string & mode );
     void close();
 
+    // Writes all buffered data to the storage device. Returns false in case of an error.
+    bool flush();
+
     // If a zero size is specified, then all still unread data is returned
     ROStreamBuf getStreamBuf( const size_t size = 0 );
 
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <filesystem>
 #include <string>
@@ -45,6 +46,9 @@ namespace System
     bool MakeDirectory( const std::string_view path );
     bool Unlink( const std::string_view path );
 
+    // Renames the file, replacing the target file if it exists.
+    bool Rename( const std::string_view from, const std::string_view to );
+
     std::string concatPath( const std::string_view left, const std::string_view right );
 
     void appendOSSpecificDirectories( std::vector<std::string> & directories );
@@ -57,6 +61,9 @@ namespace System
     // which should be considered as the current directory.
     std::string GetDataDirectory( const std::string_view appName );
 
+    // Returns the path to the directory inside the app data directory where the app keeps files which can be recreated at any time.
+    std::string GetCacheDirectory( const std::string_view appName );
+
     std::string GetParentDirectory( std::string_view path );
     std::string GetFileName( std::string_view path );
     std::string GetStem( const std::string_view path );
@@ -64,6 +71,10 @@ namespace System
     bool IsFile( const std::string_view path );
     bool IsDirectory( const std::string_view path );
 
+    // Gets the size and the last modification time of the file. The modification time can only be compared with the modification time
+    // of the same file obtained by this function. Returns false if the file does not exist or the information cannot be obtained.
+    bool GetFileSizeAndModificationTime( const std::string_view path, uint64_t & size, int64_t & modificationTime );
+
     bool GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath );
 
     // Resolves the wildcard pattern 'glob' and appends matching paths to 'fileNames'. Supported wildcards are '?' and '*'.
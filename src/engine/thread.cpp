@@ -20,8 +20,10 @@
 
 #include "thread.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
+#include <vector>
 
 #if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
 namespace
@@ -50,6 +52,148 @@ namespace
 }
 #endif
 
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+namespace
+{
+    // Worker threads used by MultiThreading::parallelFor(). These threads are created on demand and are kept alive between calls
+    // because the creation of new threads for every call is too expensive for short tasks.
+    class ParallelForPool
+    {
+    public:
+        ParallelForPool() = default;
+        ParallelForPool( const ParallelForPool & ) = delete;
+
+        ~ParallelForPool()
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _exitFlag = true;
+            }
+
+            _workerNotification.notify_all();
+
+            for ( std::thread & worker : _workers ) {
+                worker.join();
+            }
+        }
+
+        ParallelForPool & operator=( const ParallelForPool & ) = delete;
+
+        // Calls 'func' for each index in the range [0, count) using 'threadCount' threads, one of which is the calling thread. Returns false
+        // without calling 'func' if the pool is being used by another call at the moment.
+        bool run( const size_t count, const uint32_t threadCount, const std::function<void( const size_t, const uint32_t )> & func )
+        {
+            assert( threadCount > 1 );
+
+            const std::unique_lock<std::mutex> runLock( _runMutex, std::try_to_lock );
+            if ( !runLock.owns_lock() ) {
+                return false;
+            }
+
+            while ( _workers.size() + 1 < threadCount ) {
+                _workers.emplace_back( &ParallelForPool::_workerThread, this, static_cast<uint32_t>( _workers.size() + 1 ) );
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _func = &func;
+                _count = count;
+                _nextIndex = 0;
+                _threadCount = threadCount;
+                _pendingWorkerCount = threadCount - 1;
+
+                ++_taskId;
+            }
+
+            _workerNotification.notify_all();
+
+            _processIndexes( 0 );
+
+            {
+                std::unique_lock<std::mutex> lock( _mutex );
+
+                _masterNotification.wait( lock, [this] { return _pendingWorkerCount == 0; } );
+
+                _func = nullptr;
+            }
+
+            return true;
+        }
+
+    private:
+        // Held during the whole run() call, so only one call can use the worker threads at a time
+        std::mutex _runMutex;
+
+        std::mutex _mutex;
+
+        std::condition_variable _masterNotification;
+        std::condition_variable _workerNotification;
+
+        std::vector<std::thread> _workers;
+
+        const std::function<void( const size_t, const uint32_t )> * _func{ nullptr };
+        size_t _count{ 0 };
+        std::atomic<size_t> _nextIndex{ 0 };
+
+        // The number of threads (including the calling thread) participating in the current task
+        uint32_t _threadCount{ 0 };
+        uint32_t _pendingWorkerCount{ 0 };
+
+        // Incremented for each new task, so the worker threads can distinguish a new task from a spurious wakeup
+        uint64_t _taskId{ 0 };
+
+        bool _exitFlag{ false };
+
+        void _processIndexes( const uint32_t threadIdx )
+        {
+            assert( _func != nullptr );
+
+            for ( size_t i = _nextIndex++; i < _count; i = _nextIndex++ ) {
+                ( *_func )( i, threadIdx );
+            }
+        }
+
+        void _workerThread( const uint32_t threadIdx )
+        {
+            uint64_t lastTaskId = 0;
+
+            while ( true ) {
+                {
+                    std::unique_lock<std::mutex> lock( _mutex );
+
+                    _workerNotification.wait( lock, [this, threadIdx, lastTaskId] { return _exitFlag || ( _taskId != lastTaskId && threadIdx < _threadCount ); } );
+
+                    if ( _exitFlag ) {
+                        return;
+                    }
+
+                    lastTaskId = _taskId;
+                }
+
+                _processIndexes( threadIdx );
+
+                bool isLastWorker = false;
+
+                {
+                    const std::scoped_lock<std::mutex> lock( _mutex );
+
+                    assert( _pendingWorkerCount > 0 );
+
+                    --_pendingWorkerCount;
+                    isLastWorker = ( _pendingWorkerCount == 0 );
+                }
+
+                if ( isLastWorker ) {
+                    _masterNotification.notify_one();
+                }
+            }
+        }
+    };
+}
+#endif
+
 namespace MultiThreading
 {
     void AsyncManager::createWorker()
@@ -150,4 +294,38 @@ namespace MultiThreading
             manager->executeTask();
         }
     }
+
+    uint32_t getMaxParallelThreads()
+    {
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
+        return 1;
+#else
+        // This value is only a hint and may be 0 if it is not computable
+        return std::max( std::thread::hardware_concurrency(), 1U );
+#endif
+    }
+
+    void parallelFor( const size_t count, const uint32_t threadCount, const std::function<void( const size_t, const uint32_t )> & func )
+    {
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+        // There is no point in using more threads than there are indexes to process
+        const size_t threadsToUse = std::min<size_t>( threadCount, count );
+
+        if ( threadsToUse > 1 ) {
+            static ParallelForPool pool;
+
+            if ( pool.run( count, static_cast<uint32_t>( threadsToUse ), func ) ) {
+                return;
+            }
+
+            // The worker threads are busy with another call (e.g. a nested one), so all indexes are processed by the calling thread
+        }
+#else
+        (void)threadCount;
+#endif
+
+        for ( size_t i = 0; i < count; ++i ) {
+            func( i, 0 );
+        }
+    }
 }
@@ -22,6 +22,9 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -70,4 +73,15 @@ namespace MultiThreading
 
         static void _workerThread( AsyncManager * manager );
     };
+
+    // Returns the number of threads (including the calling thread) that can run simultaneously on this system. Always returns at least 1.
+    uint32_t getMaxParallelThreads();
+
+    // Calls 'func' for each index in the range [0, count) using up to 'threadCount' threads, one of which is the calling thread. The second
+    // argument of 'func' is the index of the thread in the range [0, threadCount) which performs the call, so it can be used to access
+    // thread-specific data. Indexes are distributed between threads dynamically, so 'func' must not depend on the order of calls. This
+    // function returns after all calls are completed. If multithreading is not supported, all calls are performed by the calling thread.
+    // Worker threads are created on first use and are reused by subsequent calls. Only one call at a time can use them, so if they are busy
+    // with another call (e.g. in case of nested calls), all calls are performed by the calling thread.
+    void parallelFor( const size_t count, const uint32_t threadCount, const std::function<void( const size_t, const uint32_t )> & func );
 }
@@ -37,6 +37,7 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "logging.h"
@@ -278,22 +279,6 @@ namespace
         return iter->second;
     }
 
-    uint32_t crc32b( const std::string_view str )
-    {
-        uint32_t crc = 0xFFFFFFFF;
-
-        for ( const char ch : str ) {
-            crc ^= static_cast<uint32_t>( ch );
-
-            for ( int bit = 0; bit < 8; ++bit ) {
-                const uint32_t poly = ( crc & 1 ) ? 0xEDB88320 : 0x0;
-                crc = ( crc >> 1 ) ^ poly;
-            }
-        }
-
-        return ~crc;
-    }
-
     bool getCharsetFromHeader( const std::string & hdr, std::string & charset )
     {
         constexpr std::string_view hdrEntry{ "Content-Type:" };
@@ -329,30 +314,25 @@ namespace
     public:
         MOFile() = default;
 
-        const char * ngettext( const char * str, const size_t plural ) const
+        const char * ngettext( const Translation::HashedString & str, const size_t plural ) const
         {
             if ( !_isValid ) {
                 assert( 0 );
 
-                return stripContext( str );
-            }
-
-            const auto iter = std::as_const( _translations ).find( crc32b( str ) );
-            if ( iter == _translations.cend() ) {
-                return stripContext( str );
+                return stripContext( str.str );
             }
 
-            const auto & [dummy, pluralFormTranslations] = *iter;
-            if ( plural >= pluralFormTranslations.size() ) {
-                return stripContext( str );
+            const Entry * entry = _findEntry( str.hash );
+            if ( entry == nullptr || plural >= entry->formCount ) {
+                return stripContext( str.str );
             }
 
-            const std::string & translatedStr = pluralFormTranslations[plural];
-            if ( translatedStr.empty() ) {
-                return stripContext( str );
+            const char * translatedStr = _strings.data() + _formOffsets[entry->firstForm + plural];
+            if ( *translatedStr == '\0' ) {
+                return stripContext( str.str );
             }
 
-            return translatedStr.c_str();
+            return translatedStr;
         }
 
         bool load( const std::string_view langName, const std::string & fileName )
@@ -372,6 +352,8 @@ namespace
 
             sf.close();
 
+            _checksum = fheroes2::calculateCRC32( sb.data(), sb.size() );
+
             {
                 const uint32_t magicNumber = sb.getLE32();
                 if ( sb.fail() ) {
@@ -429,6 +411,9 @@ namespace
             // specific implementation and is not documented. See https://www.gnu.org/software/gettext/manual/html_node/MO-Files.html
             // for details.
 
+            std::vector<std::pair<std::string_view, Entry>> entries;
+            entries.reserve( stringsCount );
+
             for ( uint32_t i = 0; i < stringsCount; ++i ) {
                 sb.seek( originalStringsTableOffset + i * 8 );
 
@@ -476,18 +461,56 @@ namespace
 
                 static_assert( std::is_same_v<std::remove_const_t<std::remove_reference_t<decltype( *tranBufPtr )>>, unsigned char> );
 
-                if ( const auto [dummy, inserted]
-                     = _translations.try_emplace( crc32b( origStr ), StringSplit( { reinterpret_cast<const char *>( tranBufPtr ), tranBufLen }, '\0' ) );
-                     !inserted ) {
-                    ERROR_LOG( "Hash collision detected for string \"" << origStr << "\"" )
+                // All plural forms of all translations are stored one after another in a single buffer. Plural forms are separated
+                // by the null character in the MO file so each of them is already a null-terminated string within this buffer.
+                Entry & entry = entries.emplace_back( origStr, Entry{} ).second;
+                entry.hash = Translation::getStringHash( origStr );
+                entry.firstForm = static_cast<uint32_t>( _formOffsets.size() );
+
+                const size_t translationOffset = _strings.size();
+                _strings.append( reinterpret_cast<const char *>( tranBufPtr ), tranBufLen );
+                _strings.push_back( '\0' );
+
+                _formOffsets.push_back( static_cast<uint32_t>( translationOffset ) );
+
+                for ( size_t pos = translationOffset; pos < translationOffset + tranBufLen; ++pos ) {
+                    if ( _strings[pos] == '\0' ) {
+                        _formOffsets.push_back( static_cast<uint32_t>( pos + 1 ) );
+                    }
                 }
+
+                entry.formCount = static_cast<uint32_t>( _formOffsets.size() ) - entry.firstForm;
             }
 
-            if ( _translations.empty() ) {
+            if ( entries.empty() ) {
                 ERROR_LOG( "There are no translated strings in " << fileName )
                 return false;
             }
 
+            // Open addressing table with the load factor not higher than 0.5. Hashes are CRC32 values which are evenly
+            // distributed so their lower bits are used as the index directly.
+            size_t tableSize = 1;
+            while ( tableSize < entries.size() * 2 ) {
+                tableSize *= 2;
+            }
+
+            _entries.resize( tableSize );
+            _entryIndexMask = static_cast<uint32_t>( tableSize - 1 );
+
+            for ( const auto & [origStr, entry] : entries ) {
+                if ( _findEntry( entry.hash ) != nullptr ) {
+                    ERROR_LOG( "Hash collision detected for string \"" << origStr << "\"" )
+                    continue;
+                }
+
+                uint32_t index = entry.hash & _entryIndexMask;
+                while ( _entries[index].formCount > 0 ) {
+                    index = ( index + 1 ) & _entryIndexMask;
+                }
+
+                _entries[index] = entry;
+            }
+
             _locale = langToLocale( langName );
 
             // The empty line in the MO file goes first (since the original lines in it are sorted in increasing lexicographical order),
@@ -540,10 +563,43 @@ namespace
             return _isValid;
         }
 
+        uint32_t getChecksum() const
+        {
+            return _checksum;
+        }
+
     private:
+        struct Entry
+        {
+            uint32_t hash{ 0 };
+            uint32_t firstForm{ 0 };
+
+            // Empty slots of the table have no forms.
+            uint32_t formCount{ 0 };
+        };
+
+        const Entry * _findEntry( const uint32_t hash ) const
+        {
+            if ( _entries.empty() ) {
+                return nullptr;
+            }
+
+            for ( uint32_t index = hash & _entryIndexMask; _entries[index].formCount > 0; index = ( index + 1 ) & _entryIndexMask ) {
+                if ( _entries[index].hash == hash ) {
+                    return &_entries[index];
+                }
+            }
+
+            return nullptr;
+        }
+
         LocaleType _locale{ LocaleType::LOCALE_EN };
-        std::unordered_map<uint32_t, std::vector<std::string>> _translations;
+        std::vector<Entry> _entries;
+        uint32_t _entryIndexMask{ 0 };
+        std::vector<uint32_t> _formOffsets;
+        std::string _strings;
         std::string _encoding;
+        uint32_t _checksum{ 0 };
         bool _isValid{ false };
     };
 
@@ -601,17 +657,36 @@ void Translation::reset()
     current = nullptr;
 }
 
+uint32_t Translation::getChecksum()
+{
+    return current ? current->getChecksum() : 0;
+}
+
+const char * Translation::gettext( const HashedString & str )
+{
+    return current ? current->ngettext( str, 0 ) : stripContext( str.str );
+}
+
 const char * Translation::gettext( const std::string & str )
 {
-    return current ? current->ngettext( str.c_str(), 0 ) : stripContext( str.c_str() );
+    return current ? current->ngettext( { str.c_str(), getStringHash( str ) }, 0 ) : stripContext( str.c_str() );
 }
 
 const char * Translation::gettext( const char * str )
 {
-    return current ? current->ngettext( str, 0 ) : stripContext( str );
+    return current ? current->ngettext( { str, getStringHash( str ) }, 0 ) : stripContext( str );
 }
 
 const char * Translation::ngettext( const char * str, const char * plural, size_t n )
+{
+    if ( current == nullptr ) {
+        return stripContext( n == 1 ? str : plural );
+    }
+
+    return ngettext( HashedString{ str, getStringHash( str ) }, plural, n );
+}
+
+const char * Translation::ngettext( const HashedString & str, const char * plural, size_t n )
 {
     if ( current )
         switch ( current->getLocale() ) {
@@ -667,7 +742,7 @@ const char * Translation::ngettext( const char * str, const char * plural, size_
             break;
         }
 
-    return stripContext( n == 1 ? str : plural );
+    return stripContext( n == 1 ? str.str : plural );
 }
 
 std::string Translation::StringLower( std::string str )
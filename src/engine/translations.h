@@ -23,9 +23,12 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace Translation
@@ -46,6 +49,51 @@ namespace Translation
     // Resets the current language to the default language (English).
     void reset();
 
+    // Returns the CRC32 of the translation file of the current language, or 0 if the default language is used.
+    uint32_t getChecksum();
+
+    constexpr std::array<uint32_t, 256> generateCRC32Table()
+    {
+        std::array<uint32_t, 256> table{};
+
+        for ( uint32_t i = 0; i < 256; ++i ) {
+            uint32_t crc = i;
+
+            for ( int bit = 0; bit < 8; ++bit ) {
+                crc = ( crc & 1 ) ? ( crc >> 1 ) ^ 0xEDB88320 : ( crc >> 1 );
+            }
+
+            table[i] = crc;
+        }
+
+        return table;
+    }
+
+    inline constexpr std::array<uint32_t, 256> crc32Table = generateCRC32Table();
+
+    // Returns the CRC32 of the given string which is used as the key of its translation.
+    // It is calculated at compile time for string literals passed to _() and _n() macros.
+    constexpr uint32_t getStringHash( const std::string_view str )
+    {
+        uint32_t crc = 0xFFFFFFFF;
+
+        for ( const char ch : str ) {
+            crc = ( crc >> 8 ) ^ crc32Table[( crc ^ static_cast<unsigned char>( ch ) ) & 0xFF];
+        }
+
+        return ~crc;
+    }
+
+    struct HashedString
+    {
+        const char * str;
+        uint32_t hash;
+    };
+
+    const char * gettext( const HashedString & str );
+    const char * ngettext( const HashedString & str, const char * plural, size_t num );
+
+    // These functions calculate the hash of the string at runtime. Use them for strings which are not literals.
     const char * gettext( const char * str );
     const char * gettext( const std::string & str );
     const char * ngettext( const char * str, const char * plural, size_t num );
@@ -54,8 +102,11 @@ namespace Translation
     std::string StringLower( std::string str );
 }
 
-#define _( str ) Translation::gettext( str )
-#define _n( str, plural, num ) Translation::ngettext( str, plural, num )
+// Only string literals can be passed as the 'str' argument since its hash is calculated at compile time.
+#define TRANSLATION_HASHED_STRING( str ) Translation::HashedString{ str, std::integral_constant<uint32_t, Translation::getStringHash( str )>::value }
+
+#define _( str ) Translation::gettext( TRANSLATION_HASHED_STRING( str ) )
+#define _n( str, plural, num ) Translation::ngettext( TRANSLATION_HASHED_STRING( str ), plural, num )
 
 constexpr const char * gettext_noop( const char * s )
 {
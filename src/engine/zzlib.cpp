@@ -23,6 +23,7 @@
 
 #include "zzlib.h"
 
+#include <algorithm>
 #include <cstring>
 #include <ostream>
 
@@ -35,6 +36,9 @@
 namespace
 {
     constexpr uint16_t FORMAT_VERSION_0 = 0;
+
+    // The size of compressed and uncompressed data buffers used by UnzipStream.
+    constexpr size_t unzipStreamBufferSize = 64 * 1024;
 }
 
 std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t srcSize, size_t realSize /* = 0 */ )
@@ -203,3 +207,252 @@ fheroes2::Image Compression::CreateImageFromZlib( int32_t width, int32_t height,
     }
     return out;
 }
+
+Compression::UnzipStream::UnzipStream( IStreamBase & inputStream )
+    : _inputStream( inputStream )
+    , _zStream( std::make_unique<z_stream>() )
+{
+    const uint32_t rawSize = _inputStream.get32();
+    const uint32_t zipSize = _inputStream.get32();
+    const uint16_t version = _inputStream.get16();
+
+    _inputStream.skip( 2 ); // Unused bytes
+
+    if ( _inputStream.fail() || zipSize == 0 || version != FORMAT_VERSION_0 ) {
+        setFail();
+        return;
+    }
+
+    // The inflateInit() macro uses an old-style cast.
+    const int ret = inflateInit_( _zStream.get(), ZLIB_VERSION, static_cast<int>( sizeof( z_stream ) ) );
+    if ( ret != Z_OK ) {
+        ERROR_LOG( "zlib error: " << ret )
+
+        // The stream should not be released in the destructor if its initialization has failed.
+        _zStream.reset();
+
+        setFail();
+        return;
+    }
+
+    _zipSizeLeft = zipSize;
+    _rawSizeLeft = rawSize;
+    _rawSizeToUnzip = rawSize;
+
+    _outputBuffer.resize( unzipStreamBufferSize );
+
+    if ( _rawSizeToUnzip == 0 && !_finishUnzipping() ) {
+        setFail();
+    }
+}
+
+Compression::UnzipStream::~UnzipStream()
+{
+    if ( _zStream ) {
+        inflateEnd( _zStream.get() );
+    }
+}
+
+void Compression::UnzipStream::skip( size_t size )
+{
+    while ( size > 0 ) {
+        if ( _outputPos == _outputSize && !_unzipNextPortion() ) {
+            setFail();
+            return;
+        }
+
+        const size_t sizeToSkip = std::min( size, _outputSize - _outputPos );
+
+        _outputPos += sizeToSkip;
+        _rawSizeLeft -= sizeToSkip;
+        size -= sizeToSkip;
+    }
+}
+
+uint16_t Compression::UnzipStream::getBE16()
+{
+    uint16_t v = ( static_cast<uint16_t>( get8() ) << 8 );
+
+    v |= get8();
+
+    return v;
+}
+
+uint16_t Compression::UnzipStream::getLE16()
+{
+    uint16_t v = get8();
+
+    v |= ( static_cast<uint16_t>( get8() ) << 8 );
+
+    return v;
+}
+
+uint32_t Compression::UnzipStream::getBE32()
+{
+    uint32_t v = ( static_cast<uint32_t>( get8() ) << 24 );
+
+    v |= ( static_cast<uint32_t>( get8() ) << 16 );
+    v |= ( static_cast<uint32_t>( get8() ) << 8 );
+    v |= get8();
+
+    return v;
+}
+
+uint32_t Compression::UnzipStream::getLE32()
+{
+    uint32_t v = get8();
+
+    v |= ( static_cast<uint32_t>( get8() ) << 8 );
+    v |= ( static_cast<uint32_t>( get8() ) << 16 );
+    v |= ( static_cast<uint32_t>( get8() ) << 24 );
+
+    return v;
+}
+
+std::vector<uint8_t> Compression::UnzipStream::getRaw( size_t size )
+{
+    if ( size == 0 ) {
+        size = _rawSizeLeft;
+    }
+    else if ( size > _rawSizeLeft ) {
+        // There is not enough data left. The size might be read from corrupted data so it cannot be trusted.
+        setFail();
+
+        size = _rawSizeLeft;
+    }
+
+    std::vector<uint8_t> v( size, 0 );
+
+    size_t pos = 0;
+
+    while ( pos < size ) {
+        if ( _outputPos == _outputSize && !_unzipNextPortion() ) {
+            setFail();
+            break;
+        }
+
+        const size_t sizeToCopy = std::min( size - pos, _outputSize - _outputPos );
+
+        memcpy( v.data() + pos, _outputBuffer.data() + _outputPos, sizeToCopy );
+
+        _outputPos += sizeToCopy;
+        _rawSizeLeft -= sizeToCopy;
+        pos += sizeToCopy;
+    }
+
+    return v;
+}
+
+bool Compression::UnzipStream::verify()
+{
+    skip( _rawSizeLeft );
+
+    return !fail();
+}
+
+uint8_t Compression::UnzipStream::get8()
+{
+    if ( _outputPos == _outputSize && !_unzipNextPortion() ) {
+        setFail();
+
+        return 0;
+    }
+
+    --_rawSizeLeft;
+
+    return _outputBuffer[_outputPos++];
+}
+
+bool Compression::UnzipStream::_unzipNextPortion()
+{
+    if ( fail() || _rawSizeLeft == 0 ) {
+        return false;
+    }
+
+    while ( true ) {
+        if ( _zStream->avail_in == 0 && !_readNextInput() ) {
+            return false;
+        }
+
+        // Do not unzip more data than declared in the chunk header.
+        const size_t outputSize = std::min( _rawSizeToUnzip, _outputBuffer.size() );
+
+        _zStream->next_out = _outputBuffer.data();
+        _zStream->avail_out = static_cast<uInt>( outputSize );
+
+        const int ret = inflate( _zStream.get(), Z_NO_FLUSH );
+        if ( ret != Z_OK && ret != Z_STREAM_END ) {
+            ERROR_LOG( "zlib error: " << ret )
+            return false;
+        }
+
+        _outputPos = 0;
+        _outputSize = outputSize - _zStream->avail_out;
+        _rawSizeToUnzip -= _outputSize;
+
+        if ( _outputSize > 0 ) {
+            // All declared data has been unzipped, the stream is marked as failed right away if it is not properly terminated.
+            if ( _rawSizeToUnzip == 0 && ret != Z_STREAM_END && !_finishUnzipping() ) {
+                setFail();
+            }
+
+            return true;
+        }
+
+        if ( ret == Z_STREAM_END ) {
+            // The compressed data ends earlier than declared in the chunk header.
+            return false;
+        }
+    }
+}
+
+bool Compression::UnzipStream::_readNextInput()
+{
+    if ( _zipSizeLeft == 0 ) {
+        // The compressed data is truncated.
+        return false;
+    }
+
+    _inputBuffer = _inputStream.getRaw( std::min( _zipSizeLeft, unzipStreamBufferSize ) );
+    if ( _inputStream.fail() || _inputBuffer.empty() ) {
+        return false;
+    }
+
+    _zipSizeLeft -= _inputBuffer.size();
+
+    _zStream->next_in = _inputBuffer.data();
+    _zStream->avail_in = static_cast<uInt>( _inputBuffer.size() );
+
+    return true;
+}
+
+bool Compression::UnzipStream::_finishUnzipping()
+{
+    // There must be no more data, so a single byte of output space is enough to find out whether there is any.
+    uint8_t extraData = 0;
+
+    while ( true ) {
+        if ( _zStream->avail_in == 0 && !_readNextInput() ) {
+            ERROR_LOG( "The compressed data is truncated." )
+            return false;
+        }
+
+        _zStream->next_out = &extraData;
+        _zStream->avail_out = 1;
+
+        const int ret = inflate( _zStream.get(), Z_NO_FLUSH );
+        if ( ret != Z_OK && ret != Z_STREAM_END ) {
+            ERROR_LOG( "zlib error: " << ret )
+            return false;
+        }
+
+        if ( _zStream->avail_out == 0 ) {
+            ERROR_LOG( "The compressed data contains more data than declared." )
+            return false;
+        }
+
+        if ( ret == Z_STREAM_END ) {
+            return true;
+        }
+    }
+}
@@ -25,13 +25,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "image.h"
+#include "serialize.h"
 
-class IStreamBase;
-class OStreamBase;
-class IStreamBuf;
+struct z_stream_s;
 
 namespace Compression
 {
@@ -54,4 +54,65 @@ namespace Compression
     bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream );
 
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
+
+    // Stream which reads the zipped chunk (written by zipStreamBuf()) from the given input stream and unzips it on the fly.
+    // Unlike unzipStream() only small portions of compressed and uncompressed data are kept in memory at any moment.
+    // The stream is marked as failed if the chunk header is invalid or the compressed data is corrupted.
+    class UnzipStream final : public IStreamBase
+    {
+    public:
+        explicit UnzipStream( IStreamBase & inputStream );
+        UnzipStream( const UnzipStream & ) = delete;
+
+        ~UnzipStream() override;
+
+        UnzipStream & operator=( const UnzipStream & ) = delete;
+
+        void skip( size_t size ) override;
+
+        uint16_t getBE16() override;
+        uint16_t getLE16() override;
+        uint32_t getBE32() override;
+        uint32_t getLE32() override;
+
+        // If a zero size is specified, then all still unread data is returned
+        std::vector<uint8_t> getRaw( size_t size ) override;
+
+        // Unzips all still unread data without storing it. Returns false if the data is corrupted. The checksum of the data is
+        // verified as soon as the last portion of data is unzipped, so if all data has been read, this call only checks its result.
+        bool verify();
+
+    private:
+        IStreamBase & _inputStream;
+
+        std::unique_ptr<z_stream_s> _zStream;
+
+        std::vector<uint8_t> _inputBuffer;
+        std::vector<uint8_t> _outputBuffer;
+
+        // Read position and the amount of unzipped data in the output buffer.
+        size_t _outputPos{ 0 };
+        size_t _outputSize{ 0 };
+
+        // The amount of compressed data which has not been read from the input stream yet.
+        size_t _zipSizeLeft{ 0 };
+
+        // The amount of uncompressed data which has not been read from this stream yet.
+        size_t _rawSizeLeft{ 0 };
+
+        // The amount of uncompressed data which has not been unzipped yet.
+        size_t _rawSizeToUnzip{ 0 };
+
+        uint8_t get8() override;
+
+        // Unzips the next portion of data into the output buffer. Returns false if there is no more data or in case of an error.
+        bool _unzipNextPortion();
+
+        // Reads the next portion of compressed data from the input stream. Returns false if there is no more data or in case of an error.
+        bool _readNextInput();
+
+        // Checks that the compressed data ends right after all declared data has been unzipped. The checksum of the data is verified
+        // by zlib only at the end of the compressed data. Returns false if the data is corrupted.
+        bool _finishUnzipping();
+    };
 }
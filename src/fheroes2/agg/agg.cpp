@@ -27,6 +27,7 @@
 
 #include "agg.h"
 #include "agg_file.h"
+#include "agg_image.h"
 #include "dir.h"
 #include "settings.h"
 #include "tools.h"
@@ -50,6 +51,27 @@ std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const boo
     return heroes2_agg.read( key );
 }
 
+fheroes2::AGGFileData AGG::getDataViewFromAggFile( const std::string & key, const bool ignoreExpansion )
+{
+    if ( !ignoreExpansion && heroes2x_agg.isGood() ) {
+        fheroes2::AGGFileData data = heroes2x_agg.readData( key );
+        if ( !data.empty() )
+            return data;
+    }
+
+    return heroes2_agg.readData( key );
+}
+
+uint32_t AGG::getAggFilesChecksum()
+{
+    const uint32_t checksum = heroes2_agg.getIndexChecksum();
+    if ( !heroes2x_agg.isGood() ) {
+        return checksum;
+    }
+
+    return ( checksum << 5 ) + ( checksum >> 27 ) + heroes2x_agg.getIndexChecksum();
+}
+
 AGG::AGGInitializer::AGGInitializer()
 {
     if ( init() ) {
@@ -59,6 +81,14 @@ AGG::AGGInitializer::AGGInitializer()
     throw std::logic_error( "No AGG data files found." );
 }
 
+AGG::AGGInitializer::~AGGInitializer()
+{
+    // The prefetching worker thread must not outlive the AGG files whose data it uses.
+    fheroes2::AGG::stopICNPrefetching();
+    fheroes2::AGG::saveICNCache();
+    fheroes2::AGG::logICNLoadingStats();
+}
+
 bool AGG::AGGInitializer::init()
 {
     const ListFiles aggFileNames = Settings::FindFiles( "data", ".agg", false );
@@ -27,6 +27,8 @@
 #include <string>
 #include <vector>
 
+#include "agg_file.h"
+
 namespace AGG
 {
     class AGGInitializer
@@ -36,7 +38,7 @@ namespace AGG
         AGGInitializer( const AGGInitializer & ) = delete;
         AGGInitializer & operator=( const AGGInitializer & ) = delete;
 
-        ~AGGInitializer() = default;
+        ~AGGInitializer();
 
         const std::string & getOriginalAGGFilePath() const
         {
@@ -56,4 +58,10 @@ namespace AGG
     };
 
     std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+
+    // Returns the file data without copying it when the AGG file is memory mapped. The data must not outlive the AGG initializer.
+    fheroes2::AGGFileData getDataViewFromAggFile( const std::string & key, const bool ignoreExpansion );
+
+    // Returns a checksum which identifies the content of the used AGG files.
+    uint32_t getAggFilesChecksum();
 }
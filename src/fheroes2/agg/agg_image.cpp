@@ -24,10 +24,14 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <random>
 #include <set>
 #include <stdexcept>
@@ -42,14 +46,19 @@
 #include "game_language.h"
 #include "h2d.h"
 #include "icn.h"
+#include "icn_cache.h"
 #include "image.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "math_base.h"
 #include "pal.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
+#include "system.h"
+#include "thread.h"
 #include "til.h"
+#include "timing.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_button.h"
@@ -57,6 +66,7 @@
 #include "ui_language.h"
 #include "ui_text.h"
 #include "ui_tool.h"
+#include "version.h"
 
 namespace
 {
@@ -281,12 +291,68 @@ namespace
             // Restore the original font.
             _icnVsSprite[ICN::FONT] = _normalFont;
             _icnVsSprite[ICN::SMALFONT] = _smallFont;
-            _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED] = _buttonGoodReleasedFont;
-            _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED] = _buttonGoodPressedFont;
-            _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED] = _buttonEvilReleasedFont;
-            _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED] = _buttonEvilPressedFont;
 
-            // Clear modified fonts.
+            // Button fonts are always generated for the current language from the original ones.
+            clearButtonFonts();
+            clearModifiedFonts();
+        }
+
+        // Clears all fonts. They are generated from the original ones when they are accessed for the first time.
+        void clear() const
+        {
+            if ( !_isPreserved ) {
+                return;
+            }
+
+            _icnVsSprite[ICN::FONT].clear();
+            _icnVsSprite[ICN::SMALFONT].clear();
+
+            clearButtonFonts();
+            clearModifiedFonts();
+        }
+
+        bool isPreserved() const
+        {
+            return _isPreserved;
+        }
+
+        const std::vector<fheroes2::Sprite> & getOriginalSprites( const int icnId ) const
+        {
+            assert( _isPreserved );
+
+            switch ( icnId ) {
+            case ICN::FONT:
+                return _normalFont;
+            case ICN::SMALFONT:
+                return _smallFont;
+            case ICN::BUTTON_GOOD_FONT_RELEASED:
+                return _buttonGoodReleasedFont;
+            case ICN::BUTTON_GOOD_FONT_PRESSED:
+                return _buttonGoodPressedFont;
+            case ICN::BUTTON_EVIL_FONT_RELEASED:
+                return _buttonEvilReleasedFont;
+            case ICN::BUTTON_EVIL_FONT_PRESSED:
+                return _buttonEvilPressedFont;
+            default:
+                // Did you add a new font?
+                assert( 0 );
+                break;
+            }
+
+            return _normalFont;
+        }
+
+    private:
+        static void clearButtonFonts()
+        {
+            _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED].clear();
+            _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED].clear();
+            _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED].clear();
+            _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED].clear();
+        }
+
+        static void clearModifiedFonts()
+        {
             _icnVsSprite[ICN::YELLOW_FONT].clear();
             _icnVsSprite[ICN::YELLOW_SMALLFONT].clear();
             _icnVsSprite[ICN::GRAY_FONT].clear();
@@ -298,12 +364,6 @@ namespace
             _icnVsSprite[ICN::SILVER_GRADIENT_LARGE_FONT].clear();
         }
 
-        bool isPreserved() const
-        {
-            return _isPreserved;
-        }
-
-    private:
         bool _isPreserved = false;
 
         std::vector<fheroes2::Sprite> _normalFont;
@@ -321,9 +381,12 @@ namespace
     class ButtonFontOffsetRestorer final
     {
     public:
-        ButtonFontOffsetRestorer( std::vector<fheroes2::Sprite> & font, const int32_t offsetX )
-            : _font( font )
+        ButtonFontOffsetRestorer( const int fontIcnId, const int32_t offsetX )
+            : _font( _icnVsSprite[fontIcnId] )
         {
+            // The font of the current language might be not generated yet.
+            fheroes2::AGG::GetICN( fontIcnId, 0 );
+
             _originalXOffsets.reserve( _font.size() );
 
             for ( fheroes2::Sprite & characterSprite : _font ) {
@@ -508,8 +571,8 @@ namespace
 
     void replacePOLAssetWithSW( const int id, const int assetIndex )
     {
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), true );
-        ROStreamBuf imageStream( body );
+        const fheroes2::AGGFileData body = ::AGG::getDataViewFromAggFile( ICN::getIcnFileName( id ), true );
+        ROStreamBuf imageStream( body.data(), body.size() );
 
         imageStream.seek( headerSize + assetIndex * 13 );
 
@@ -526,26 +589,22 @@ namespace
         _icnVsSprite[id][assetIndex] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
     }
 
-    void LoadOriginalICN( const int id )
+    // Decodes all images of an original ICN. This function is also called by the ICN prefetching worker thread so it must not access any global state.
+    std::vector<fheroes2::Sprite> decodeOriginalICN( const int id, const fheroes2::AGGFileData & body )
     {
-        // If this assertion blows up then something wrong with your logic and you load resources more than once!
-        assert( _icnVsSprite[id].empty() );
-
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
-
         if ( body.empty() ) {
-            return;
+            return {};
         }
 
-        ROStreamBuf imageStream( body );
+        ROStreamBuf imageStream( body.data(), body.size() );
 
         const uint32_t count = imageStream.getLE16();
         const uint32_t blockSize = imageStream.getLE32();
         if ( count == 0 || blockSize == 0 ) {
-            return;
+            return {};
         }
 
-        _icnVsSprite[id].resize( count );
+        std::vector<fheroes2::Sprite> sprites( count );
 
         for ( uint32_t i = 0; i < count; ++i ) {
             imageStream.seek( headerSize + i * 13 );
@@ -576,8 +635,413 @@ namespace
             const uint8_t * data = body.data() + headerSize + header1.offsetData;
             const uint8_t * dataEnd = data + dataSize;
 
-            _icnVsSprite[id][i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+            sprites[i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+        }
+
+        return sprites;
+    }
+
+    // Decodes original ICNs in the background so the first access to them does not stall the main thread.
+    class ICNPrefetchManager final : public MultiThreading::AsyncManager
+    {
+    public:
+        void pushTask( const int icnId, fheroes2::AGGFileData data )
+        {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            if ( icnId == _currentIcnId || _decodedSprites.find( icnId ) != _decodedSprites.end()
+                 || std::any_of( _tasks.begin(), _tasks.end(), [icnId]( const auto & task ) { return task.first == icnId; } ) ) {
+                // This ICN is already being prefetched.
+                return;
+            }
+
+            _tasks.emplace_back( icnId, std::move( data ) );
+
+            notifyWorker();
+        }
+
+        // Moves the decoded images of the given ICN to the output container. If this ICN is being decoded at the moment, waits for the decoding
+        // to complete. Returns false if the ICN was not prefetched: the caller has to decode it by itself.
+        bool takeSprites( const int icnId, std::vector<fheroes2::Sprite> & sprites )
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            // It is faster to decode the ICN on the main thread than to wait for the completion of all tasks queued before it.
+            _tasks.erase( std::remove_if( _tasks.begin(), _tasks.end(), [icnId]( const auto & task ) { return task.first == icnId; } ), _tasks.end() );
+
+            _taskCompletion.wait( lock, [this, icnId] { return _currentIcnId != icnId; } );
+
+            auto iter = _decodedSprites.find( icnId );
+            if ( iter == _decodedSprites.end() ) {
+                return false;
+            }
+
+            sprites = std::move( iter->second );
+            _decodedSprites.erase( iter );
+
+            return true;
+        }
+
+        // Removes the given ICN from prefetching and frees its decoded images, if any. This has to be done if this ICN has been loaded without
+        // taking its prefetched images, otherwise they would never be freed.
+        void removeSprites( const int icnId )
+        {
+            std::vector<fheroes2::Sprite> unusedSprites;
+            takeSprites( icnId, unusedSprites );
+        }
+
+        void removeAllTasks()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _tasks.clear();
+            _decodedSprites.clear();
+        }
+
+    private:
+        std::deque<std::pair<int, fheroes2::AGGFileData>> _tasks;
+        std::map<int, std::vector<fheroes2::Sprite>> _decodedSprites;
+
+        int _currentIcnId{ ICN::UNKNOWN };
+        fheroes2::AGGFileData _currentData;
+
+        std::condition_variable _taskCompletion;
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            if ( _tasks.empty() ) {
+                return false;
+            }
+
+            _currentIcnId = _tasks.front().first;
+            _currentData = std::move( _tasks.front().second );
+            _tasks.pop_front();
+
+            return true;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            if ( _currentIcnId == ICN::UNKNOWN ) {
+                return;
+            }
+
+            std::vector<fheroes2::Sprite> sprites;
+
+            try {
+                sprites = decodeOriginalICN( _currentIcnId, _currentData );
+            }
+            catch ( const fheroes2::InvalidDataResources & ) {
+                // The main thread will decode this ICN again and report the error.
+                sprites.clear();
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                if ( !sprites.empty() ) {
+                    _decodedSprites.try_emplace( _currentIcnId, std::move( sprites ) );
+                }
+
+                _currentIcnId = ICN::UNKNOWN;
+                _currentData = {};
+            }
+
+            _taskCompletion.notify_all();
+        }
+    };
+
+    ICNPrefetchManager icnPrefetchManager;
+
+    // Time spent by the main thread to load every ICN on its first access and whether this ICN was prefetched.
+    std::vector<std::pair<double, bool>> icnLoadingStats( ICN::LASTICN, { 0.0, false } );
+
+    // Generated and modified ICNs are stored in the persistent cache so they are not generated again on every launch.
+    fheroes2::ICNCache icnCache;
+
+    // Records of the cache which do not belong to a particular ICN.
+    const int generatedAlphabetRecordId = -1;
+    const int generatedButtonAlphabetRecordId = -2;
+
+    // The number of ICNs being generated at the moment. ICNs are often generated from other ICNs which are loaded during the generation.
+    int icnGenerationDepth = 0;
+
+    // Increased every time font ICNs are replaced by another alphabet.
+    uint32_t alphabetVersion = 0;
+
+    // Checksums of ICNs used during the generation of other ICNs. The checksums are calculated right after loading of every such ICN,
+    // or at the first access to an already loaded ICN, to find out whether the ICN has been changed by the generation code later.
+    std::map<int, uint32_t> loadedIcnChecksums;
+
+    uint32_t getICNChecksum( const int id )
+    {
+        const std::vector<uint8_t> data = fheroes2::ICNCache::serializeSprites( _icnVsSprite[id] );
+        return fheroes2::calculateCRC32( data.data(), data.size() );
+    }
+
+    std::string getICNCacheFilePath( const fheroes2::SupportedLanguage language, const bool loadOriginalAlphabet )
+    {
+        std::string fileName = std::string( "icn_" ) + fheroes2::getLanguageAbbreviation( language ) + ( loadOriginalAlphabet ? "_original" : "" ) + ".cache";
+
+        return System::concatPath( System::GetCacheDirectory( "fheroes2" ), fileName );
+    }
+
+    uint32_t getICNCacheKey()
+    {
+        // Development builds often change the generation code without changing the version so the build time is a part of the key as well.
+        // Generated ICNs also depend on the resources of the game, the images from the H2D file and the texts of the current translation.
+        const std::string key = std::to_string( MAJOR_VERSION ) + '.' + std::to_string( MINOR_VERSION ) + '.' + std::to_string( INTERMEDIATE_VERSION ) + '.'
+                                + std::to_string( BUILD_VERSION ) + ' ' + __DATE__ + ' ' + __TIME__ + ' ' + std::to_string( ::AGG::getAggFilesChecksum() ) + ' '
+                                + std::to_string( fheroes2::h2d::getChecksum() ) + ' ' + std::to_string( Translation::getChecksum() );
+
+        return fheroes2::calculateCRC32( reinterpret_cast<const uint8_t *>( key.data() ), key.size() );
+    }
+
+    bool loadICNFromCache( const int id )
+    {
+        std::vector<std::pair<int, std::vector<fheroes2::Sprite>>> icnSprites;
+        if ( !icnCache.read( id, icnSprites ) ) {
+            return false;
         }
+
+        for ( auto & [icnId, sprites] : icnSprites ) {
+            if ( !IsValidICNId( icnId ) ) {
+                continue;
+            }
+
+            if ( icnId != id ) {
+                // This ICN is not loaded through loadICN() so its prefetched images are not needed anymore.
+                icnPrefetchManager.removeSprites( icnId );
+            }
+
+            std::vector<fheroes2::Sprite> & loadedSprites = _icnVsSprite[icnId];
+
+            // Other ICNs of the record have been created or changed while generating this ICN. The generation would do the same
+            // with already loaded ICNs. Their sprites are updated in place since they might be referenced by the calling code.
+            if ( icnId != id && loadedSprites.size() == sprites.size() ) {
+                std::move( sprites.begin(), sprites.end(), loadedSprites.begin() );
+            }
+            else {
+                loadedSprites = std::move( sprites );
+            }
+        }
+
+        return !_icnVsSprite[id].empty();
+    }
+
+    void addICNToCache( const int id, const std::vector<bool> & loadedIcns )
+    {
+        std::vector<std::pair<int, std::vector<uint8_t>>> icnSprites;
+        icnSprites.emplace_back( id, fheroes2::ICNCache::serializeSprites( _icnVsSprite[id] ) );
+
+        // Some ICNs are generated together with other ICNs or change other ICNs used for their generation. All such ICNs have to be
+        // stored along with the generated ICN, no matter whether they were loaded before the generation or not, so the result of
+        // loading this ICN from the cache does not depend on the order of loading of ICNs.
+        for ( int icnId = ICN::UNKNOWN + 1; icnId < ICN::LASTICN; ++icnId ) {
+            if ( icnId == id || _icnVsSprite[icnId].empty() ) {
+                continue;
+            }
+
+            const auto iter = loadedIcnChecksums.find( icnId );
+            if ( iter == loadedIcnChecksums.end() && loadedIcns[icnId] ) {
+                // This ICN was loaded before the generation and it has not been accessed during it.
+                continue;
+            }
+
+            std::vector<uint8_t> data = fheroes2::ICNCache::serializeSprites( _icnVsSprite[icnId] );
+
+            if ( iter != loadedIcnChecksums.end() && iter->second == fheroes2::calculateCRC32( data.data(), data.size() ) ) {
+                // This ICN has not been changed after its loading so it can be loaded again in the same way.
+                continue;
+            }
+
+            icnSprites.emplace_back( icnId, std::move( data ) );
+        }
+
+        icnCache.add( id, icnSprites );
+    }
+
+    bool loadICNGroupFromCache( const int recordId )
+    {
+        std::vector<std::pair<int, std::vector<fheroes2::Sprite>>> icnSprites;
+        if ( !icnCache.read( recordId, icnSprites ) ) {
+            return false;
+        }
+
+        for ( auto & [icnId, sprites] : icnSprites ) {
+            if ( IsValidICNId( icnId ) ) {
+                _icnVsSprite[icnId] = std::move( sprites );
+            }
+        }
+
+        return true;
+    }
+
+    void addICNGroupToCache( const int recordId, const std::vector<int> & icnIds )
+    {
+        std::vector<std::pair<int, std::vector<uint8_t>>> icnSprites;
+        icnSprites.reserve( icnIds.size() );
+
+        for ( const int icnId : icnIds ) {
+            icnSprites.emplace_back( icnId, fheroes2::ICNCache::serializeSprites( _icnVsSprite[icnId] ) );
+        }
+
+        icnCache.add( recordId, icnSprites );
+    }
+
+    // Alphabets are generated only when they are accessed for the first time after a language change. Until then the fonts are empty so
+    // their first access goes through loadICN(). The generated alphabets are kept for every code page so switching between languages, for
+    // example, to render a text in another language, does not generate them again. The alphabet of the current code page is stored in
+    // the fonts and the alphabets of other code pages are stored in the maps below. They are moved between the fonts and the maps.
+    std::optional<fheroes2::SupportedLanguage> pendingAlphabetLanguage;
+    std::optional<fheroes2::SupportedLanguage> pendingButtonAlphabetLanguage;
+
+    std::map<fheroes2::CodePage, std::array<std::vector<fheroes2::Sprite>, 2>> generatedAlphabets;
+    std::map<fheroes2::CodePage, std::array<std::vector<fheroes2::Sprite>, 4>> generatedButtonAlphabets;
+
+    // Code pages of the generated alphabets which are stored in the fonts at the moment.
+    std::optional<fheroes2::CodePage> currentAlphabetCodePage;
+    std::optional<fheroes2::CodePage> currentButtonAlphabetCodePage;
+
+    const std::array<int, 2> alphabetIcnIds{ ICN::FONT, ICN::SMALFONT };
+    const std::array<int, 4> buttonAlphabetIcnIds{ ICN::BUTTON_GOOD_FONT_RELEASED, ICN::BUTTON_GOOD_FONT_PRESSED, ICN::BUTTON_EVIL_FONT_RELEASED,
+                                                   ICN::BUTTON_EVIL_FONT_PRESSED };
+
+    bool isAlphabetDependentIcnId( const int id )
+    {
+        switch ( id ) {
+        case ICN::FONT:
+        case ICN::SMALFONT:
+        // These fonts are made from the normal and small fonts.
+        case ICN::YELLOW_FONT:
+        case ICN::YELLOW_SMALLFONT:
+        case ICN::GRAY_FONT:
+        case ICN::GRAY_SMALL_FONT:
+        case ICN::WHITE_LARGE_FONT:
+        case ICN::GOLDEN_GRADIENT_FONT:
+        case ICN::GOLDEN_GRADIENT_LARGE_FONT:
+        case ICN::SILVER_GRADIENT_FONT:
+        case ICN::SILVER_GRADIENT_LARGE_FONT:
+            return true;
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    template <size_t count>
+    void generateAlphabetGroup( const fheroes2::SupportedLanguage language, std::map<fheroes2::CodePage, std::array<std::vector<fheroes2::Sprite>, count>> & alphabets,
+                                std::optional<fheroes2::CodePage> & currentCodePage, const std::array<int, count> & icnIds, const int recordId,
+                                void ( *generate )( const fheroes2::SupportedLanguage, std::vector<std::vector<fheroes2::Sprite>> & ) )
+    {
+        assert( !currentCodePage );
+
+        const fheroes2::Time generationTime;
+
+        const fheroes2::CodePage codePage = fheroes2::getCodePage( language );
+        const auto iter = alphabets.find( codePage );
+        const bool isReused = ( iter != alphabets.end() );
+
+        if ( isReused ) {
+            for ( size_t i = 0; i < count; ++i ) {
+                _icnVsSprite[icnIds[i]] = std::move( iter->second[i] );
+            }
+
+            alphabets.erase( iter );
+        }
+        else if ( !loadICNGroupFromCache( recordId ) ) {
+            // Alphabets are generated from the original fonts.
+            for ( const int icnId : icnIds ) {
+                _icnVsSprite[icnId] = alphabetPreserver.getOriginalSprites( icnId );
+            }
+
+            generate( language, _icnVsSprite );
+
+            addICNGroupToCache( recordId, { icnIds.begin(), icnIds.end() } );
+        }
+
+        currentCodePage = codePage;
+
+        if ( icnGenerationDepth > 0 ) {
+            // The alphabet might be created while generating another ICN, but it does not depend on that ICN so it is not stored along with it.
+            for ( const int icnId : icnIds ) {
+                loadedIcnChecksums[icnId] = getICNChecksum( icnId );
+            }
+        }
+
+        ++alphabetVersion;
+
+        DEBUG_LOG( DBG_ENGINE, DBG_TRACE,
+                   "Alphabet " << ICN::getIcnFileName( icnIds.front() ) << " for '" << fheroes2::getLanguageAbbreviation( language ) << "' language has been "
+                               << ( isReused ? "reused" : "generated" ) << " in " << generationTime.getS() * 1000.0 << " ms" )
+    }
+
+    template <size_t count>
+    void storeCurrentAlphabetGroup( std::map<fheroes2::CodePage, std::array<std::vector<fheroes2::Sprite>, count>> & alphabets,
+                                    std::optional<fheroes2::CodePage> & currentCodePage, const std::array<int, count> & icnIds )
+    {
+        if ( !currentCodePage ) {
+            return;
+        }
+
+        std::array<std::vector<fheroes2::Sprite>, count> & sprites = alphabets[*currentCodePage];
+
+        for ( size_t i = 0; i < count; ++i ) {
+            sprites[i] = std::move( _icnVsSprite[icnIds[i]] );
+            _icnVsSprite[icnIds[i]].clear();
+        }
+
+        currentCodePage.reset();
+    }
+
+    // Moves the generated alphabets from the fonts to the storage of alphabets before the fonts are changed.
+    void storeCurrentAlphabets()
+    {
+        storeCurrentAlphabetGroup( generatedAlphabets, currentAlphabetCodePage, alphabetIcnIds );
+        storeCurrentAlphabetGroup( generatedButtonAlphabets, currentButtonAlphabetCodePage, buttonAlphabetIcnIds );
+    }
+
+    // Creates the pending alphabet if the given ICN depends on it. Returns true if the given ICN is one of the fonts of the created alphabet.
+    bool generatePendingAlphabet( const int id )
+    {
+        if ( pendingAlphabetLanguage && isAlphabetDependentIcnId( id ) ) {
+            const fheroes2::SupportedLanguage language = *pendingAlphabetLanguage;
+            pendingAlphabetLanguage.reset();
+
+            generateAlphabetGroup( language, generatedAlphabets, currentAlphabetCodePage, alphabetIcnIds, generatedAlphabetRecordId, fheroes2::generateAlphabet );
+
+            return std::find( alphabetIcnIds.begin(), alphabetIcnIds.end(), id ) != alphabetIcnIds.end();
+        }
+
+        if ( pendingButtonAlphabetLanguage && std::find( buttonAlphabetIcnIds.begin(), buttonAlphabetIcnIds.end(), id ) != buttonAlphabetIcnIds.end() ) {
+            const fheroes2::SupportedLanguage language = *pendingButtonAlphabetLanguage;
+            pendingButtonAlphabetLanguage.reset();
+
+            generateAlphabetGroup( language, generatedButtonAlphabets, currentButtonAlphabetCodePage, buttonAlphabetIcnIds, generatedButtonAlphabetRecordId,
+                                   fheroes2::generateButtonAlphabet );
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void LoadOriginalICN( const int id )
+    {
+        // If this assertion blows up then something wrong with your logic and you load resources more than once!
+        assert( _icnVsSprite[id].empty() );
+
+        if ( icnPrefetchManager.takeSprites( id, _icnVsSprite[id] ) ) {
+            icnLoadingStats[id].second = true;
+            return;
+        }
+
+        _icnVsSprite[id] = decodeOriginalICN( id, ::AGG::getDataViewFromAggFile( ICN::getIcnFileName( id ), false ) );
     }
 
     // Helper function for LoadModifiedICN
@@ -1162,8 +1626,8 @@ namespace
 
             // We need to temporarily remove the letter-specific X offsets in the font because if not the letters will
             // be off-centered when we are displaying one letter per line
-            const ButtonFontOffsetRestorer fontReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * text = fheroes2::getSupportedText( gettext_noop( "D\nI\nS\nM\nI\nS\nS" ), fheroes2::FontType::buttonReleasedWhite() );
             getTextAdaptedSprite( _icnVsSprite[id][0], _icnVsSprite[id][1], text, ICN::EMPTY_VERTICAL_GOOD_BUTTON, ICN::REDBAK_SMALL_VERTICAL );
@@ -1193,8 +1657,8 @@ namespace
 
             // We need to temporarily remove the letter specific X offsets in the font because if not the letters will
             // be off-centered when we are displaying one letter per line
-            const ButtonFontOffsetRestorer fontReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * text = fheroes2::getSupportedText( gettext_noop( "E\nX\nI\nT" ), fheroes2::FontType::buttonReleasedWhite() );
             getTextAdaptedSprite( _icnVsSprite[id][0], _icnVsSprite[id][1], text, ICN::EMPTY_VERTICAL_GOOD_BUTTON, ICN::REDBAK_SMALL_VERTICAL );
@@ -1245,8 +1709,8 @@ namespace
                 buttonText = gettext_noop( "E\nX\nI\nT" );
             }
 
-            const ButtonFontOffsetRestorer fontRestorerReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontRestorerPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontRestorerReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontRestorerPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * translatedText = fheroes2::getSupportedText( buttonText, fheroes2::FontType{ fheroes2::FontSize::BUTTON_RELEASED, fheroes2::FontColor::WHITE } );
             fheroes2::renderTextOnButton( _icnVsSprite[id][0], _icnVsSprite[id][1], translatedText, { 3, 4 }, { 2, 5 }, { 23, 133 }, fheroes2::FontColor::WHITE );
@@ -1763,8 +2227,8 @@ namespace
 
             // We need to temporarily remove the letter specific X offsets in the font because if not the letters will
             // be off-centered when we are displaying one letter per line
-            const ButtonFontOffsetRestorer fontReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * text = fheroes2::getSupportedText( gettext_noop( "P\nA\nT\nR\nO\nL" ), fheroes2::FontType::buttonReleasedWhite() );
             getTextAdaptedSprite( _icnVsSprite[id][0], _icnVsSprite[id][1], text, ICN::EMPTY_VERTICAL_GOOD_BUTTON, ICN::REDBAK_SMALL_VERTICAL );
@@ -2206,7 +2670,7 @@ namespace
                 throw std::logic_error( "The game resources are corrupted. Please use resources from a licensed version of Heroes of Might and Magic II." );
             }
 
-            const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
+            const fheroes2::AGGFileData body = ::AGG::getDataViewFromAggFile( ICN::getIcnFileName( id ), false );
             const uint32_t crc32 = fheroes2::calculateCRC32( body.data(), body.size() );
 
             if ( id == ICN::SMALFONT ) {
@@ -3097,7 +3561,7 @@ namespace
 
                 // Since we cannot access game settings from here we are checking an existence
                 // of one of POL resources as an indicator for this version.
-                if ( !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty() ) {
+                if ( !::AGG::getDataViewFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty() ) {
                     fheroes2::Sprite editorIcon;
                     fheroes2::h2d::readImage( "main_menu_editor_icon.image", editorIcon );
 
@@ -4985,12 +5449,48 @@ namespace
     void loadICN( const int id )
     {
         if ( !_icnVsSprite[id].empty() ) {
-            // The images have been loaded.
+            // The images have been loaded. However, the ICN being generated at the moment might change them.
+            if ( icnGenerationDepth > 0 && loadedIcnChecksums.count( id ) == 0 ) {
+                loadedIcnChecksums.emplace( id, getICNChecksum( id ) );
+            }
+
             return;
         }
 
-        if ( !LoadModifiedICN( id ) ) {
-            LoadOriginalICN( id );
+        const fheroes2::Time loadingTime;
+
+        if ( generatePendingAlphabet( id ) ) {
+            // This font has been created along with the alphabet of the current language.
+        }
+        else if ( !icnCache.isOpen() ) {
+            if ( !LoadModifiedICN( id ) ) {
+                LoadOriginalICN( id );
+            }
+        }
+        else if ( !loadICNFromCache( id ) ) {
+            std::vector<bool> loadedIcns( _icnVsSprite.size() );
+            for ( size_t icnId = 0; icnId < _icnVsSprite.size(); ++icnId ) {
+                loadedIcns[icnId] = !_icnVsSprite[icnId].empty();
+            }
+
+            ++icnGenerationDepth;
+
+            const bool isModified = LoadModifiedICN( id );
+            if ( !isModified ) {
+                LoadOriginalICN( id );
+            }
+
+            --icnGenerationDepth;
+
+            if ( isModified && !_icnVsSprite[id].empty() ) {
+                addICNToCache( id, loadedIcns );
+            }
+        }
+
+        if ( id < ICN::LAST_VALID_FILE_ICN ) {
+            // This ICN might have been prefetched, but loaded in another way (modified or taken from the cache). Prefetched images taken by
+            // LoadOriginalICN() have already been removed.
+            icnPrefetchManager.removeSprites( id );
         }
 
         if ( _icnVsSprite[id].empty() ) {
@@ -4998,6 +5498,16 @@ namespace
             // In order to avoid subsequent attempts to get resources from this ICN we are making it as non-empty.
             _icnVsSprite[id].resize( 1 );
         }
+
+        if ( icnGenerationDepth > 0 ) {
+            loadedIcnChecksums[id] = getICNChecksum( id );
+        }
+        else {
+            loadedIcnChecksums.clear();
+        }
+
+        // The time includes loading of all other ICNs this ICN depends on.
+        icnLoadingStats[id].first += loadingTime.getS() * 1000.0;
     }
 
     size_t GetMaximumICNIndex( int id )
@@ -5014,14 +5524,14 @@ namespace
         if ( tilImages.empty() ) {
             tilImages.resize( 4 ); // 4 possible sides
 
-            const std::vector<uint8_t> & data = ::AGG::getDataFromAggFile( tilFileName[id], false );
+            const fheroes2::AGGFileData data = ::AGG::getDataViewFromAggFile( tilFileName[id], false );
             if ( data.size() < headerSize ) {
                 // The important resource is absent! Make sure that you are using the correct version of the game.
                 assert( 0 );
                 return 0;
             }
 
-            ROStreamBuf buffer( data );
+            ROStreamBuf buffer( data.data(), data.size() );
 
             const size_t count = buffer.getLE16();
             const int32_t width = buffer.getLE16();
@@ -5134,6 +5644,54 @@ namespace fheroes2::AGG
         return _icnVsSprite[icnId][index];
     }
 
+    void prefetchICNs( const std::vector<int> & icnIds )
+    {
+        for ( const int icnId : icnIds ) {
+            if ( !IsValidICNId( icnId ) || icnId >= ICN::LAST_VALID_FILE_ICN || !_icnVsSprite[icnId].empty() ) {
+                // Only original ICNs which have not been loaded yet can be prefetched.
+                continue;
+            }
+
+            // AGG file data is accessed only on the main thread. When the AGG file is memory mapped this is just a view of the mapped memory.
+            fheroes2::AGGFileData data = ::AGG::getDataViewFromAggFile( ICN::getIcnFileName( icnId ), false );
+            if ( data.empty() ) {
+                continue;
+            }
+
+            icnPrefetchManager.pushTask( icnId, std::move( data ) );
+        }
+    }
+
+    void stopICNPrefetching()
+    {
+        icnPrefetchManager.removeAllTasks();
+        icnPrefetchManager.stopWorker();
+    }
+
+    void logICNLoadingStats()
+    {
+#ifdef WITH_DEBUG
+        if ( !IS_DEBUG( DBG_ENGINE, DBG_INFO ) ) {
+            return;
+        }
+
+        std::vector<int> icnIds;
+        for ( int icnId = ICN::UNKNOWN + 1; icnId < ICN::LASTICN; ++icnId ) {
+            if ( icnLoadingStats[icnId].first > 0 ) {
+                icnIds.push_back( icnId );
+            }
+        }
+
+        std::sort( icnIds.begin(), icnIds.end(), []( const int left, const int right ) { return icnLoadingStats[left].first > icnLoadingStats[right].first; } );
+
+        for ( const int icnId : icnIds ) {
+            DEBUG_LOG( DBG_ENGINE, DBG_INFO,
+                       "ICN " << ICN::getIcnFileName( icnId ) << " (" << icnId << ") first access took " << icnLoadingStats[icnId].first << " ms"
+                              << ( icnLoadingStats[icnId].second ? ", prefetched" : "" ) )
+        }
+#endif
+    }
+
     uint32_t GetICNCount( int icnId )
     {
         if ( !IsValidICNId( icnId ) ) {
@@ -5161,6 +5719,11 @@ namespace fheroes2::AGG
         return _tilVsImage[tilId][shapeId][index];
     }
 
+    void saveICNCache()
+    {
+        icnCache.save();
+    }
+
     void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet )
     {
         static bool areOriginalResourcesInUse = false;
@@ -5176,12 +5739,15 @@ namespace fheroes2::AGG
                     return;
                 }
 
+                storeCurrentAlphabets();
                 alphabetPreserver.restore();
             }
             else {
                 // This can happen when we try to change a language without loading assets.
                 alphabetPreserver.preserve();
             }
+
+            pendingAlphabetLanguage.reset();
         }
         else {
             if ( !areOriginalResourcesInUse && currentCodePage == getCodePage( language ) ) {
@@ -5190,13 +5756,23 @@ namespace fheroes2::AGG
             }
 
             alphabetPreserver.preserve();
-            // Restore original letters when changing language to avoid changes to them being carried over.
-            alphabetPreserver.restore();
 
-            generateAlphabet( language, _icnVsSprite );
+            storeCurrentAlphabets();
+            // The alphabet is generated from the original letters when any font is accessed for the first time, so the fonts stay empty until then.
+            alphabetPreserver.clear();
+
+            pendingAlphabetLanguage = language;
         }
 
-        generateButtonAlphabet( language, _icnVsSprite );
+        // Every language has its own cache file since many generated ICNs contain translated text. The file is switched only when
+        // the language dependent resources are actually updated.
+        icnCache.open( getICNCacheFilePath( language, loadOriginalResources ), getICNCacheKey() );
+
+        pendingButtonAlphabetLanguage = language;
+
+        for ( const int id : buttonAlphabetIcnIds ) {
+            _icnVsSprite[id].clear();
+        }
 
         // Clear language dependent resources.
         for ( const int id : languageDependentIcnId ) {
@@ -5205,5 +5781,12 @@ namespace fheroes2::AGG
 
         currentCodePage = getCodePage( language );
         areOriginalResourcesInUse = loadOriginalResources;
+
+        ++alphabetVersion;
+    }
+
+    uint32_t getAlphabetVersion()
+    {
+        return alphabetVersion;
     }
 }
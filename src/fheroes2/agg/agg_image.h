@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 namespace fheroes2
 {
@@ -34,10 +35,26 @@ namespace fheroes2
         const Sprite & GetICN( int icnId, uint32_t index );
         uint32_t GetICNCount( int icnId );
 
+        // Starts decoding of the given original ICNs in the background so the first access to them does not stall the UI.
+        // Call this function before opening a screen which uses these ICNs. Generated ICNs are ignored.
+        void prefetchICNs( const std::vector<int> & icnIds );
+
+        // This function must be called before closing AGG files.
+        void stopICNPrefetching();
+
+        // Logs the time spent to load every ICN on its first access, the slowest ICNs first.
+        void logICNLoadingStats();
+
+        // Writes generated ICNs which are not in the persistent cache yet to the cache file.
+        void saveICNCache();
+
         // shapeId could be 0, 1, 2 or 3 only
         const Image & GetTIL( int tilId, uint32_t index, uint32_t shapeId );
 
         // This function must be called only at the time of setting up a new language.
         void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet );
+
+        // Returns a number which is changed every time font images are replaced by another alphabet.
+        uint32_t getAlphabetVersion();
     }
 }
@@ -0,0 +1,356 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "icn_cache.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "image.h"
+#include "logging.h"
+#include "serialize.h"
+#include "system.h"
+#include "tools.h"
+
+namespace
+{
+    const uint32_t cacheFileMagic = 0x43494846; // "FHIC"
+
+    // Increase this value every time the layout of the cache file is changed.
+    const uint32_t cacheFileFormatVersion = 1;
+
+    // Magic, format version, key, record count and index checksum.
+    const size_t cacheFileHeaderSize = sizeof( uint32_t ) * 5;
+
+    // ICN ID, offset, size and checksum.
+    const size_t cacheFileIndexEntrySize = sizeof( uint32_t ) * 4;
+
+    // Width, height, X and Y offsets and a flag of a single-layer image.
+    const size_t spriteHeaderSize = sizeof( uint32_t ) * 4 + 1;
+
+    // Generated ICNs take a lot of space in uncompressed form so new records are not added to a huge cache file.
+    const size_t maxCacheFileSize = 64 * 1024 * 1024;
+
+    // Even a record of the biggest generated ICNs, like full-screen images, takes about 1 MB. Bigger records are not expected.
+    const size_t maxRecordSize = 4 * 1024 * 1024;
+}
+
+namespace fheroes2
+{
+    void ICNCache::open( const std::string & filePath, const uint32_t key )
+    {
+        if ( _filePath == filePath && _key == key ) {
+            return;
+        }
+
+        save();
+        _unload();
+
+        _filePath = filePath;
+        _key = key;
+
+        _load();
+    }
+
+    void ICNCache::save()
+    {
+        if ( _newRecords.empty() ) {
+            return;
+        }
+
+        std::vector<std::pair<int, std::pair<const uint8_t *, size_t>>> records;
+        records.reserve( _records.size() + _newRecords.size() );
+
+        for ( const auto & [icnId, record] : _records ) {
+            if ( _newRecords.count( icnId ) == 0 ) {
+                records.emplace_back( icnId, std::make_pair( _data + record.offset, static_cast<size_t>( record.size ) ) );
+            }
+        }
+
+        for ( const auto & [icnId, data] : _newRecords ) {
+            records.emplace_back( icnId, std::make_pair( data.data(), data.size() ) );
+        }
+
+        RWStreamBuf index( records.size() * cacheFileIndexEntrySize );
+        size_t offset = cacheFileHeaderSize + records.size() * cacheFileIndexEntrySize;
+
+        for ( const auto & [icnId, data] : records ) {
+            index.putLE32( static_cast<uint32_t>( icnId ) );
+            index.putLE32( static_cast<uint32_t>( offset ) );
+            index.putLE32( static_cast<uint32_t>( data.second ) );
+            index.putLE32( calculateCRC32( data.first, data.second ) );
+
+            offset += data.second;
+        }
+
+        System::MakeDirectory( System::GetParentDirectory( _filePath ) );
+
+        const std::string tempFilePath = _filePath + ".tmp";
+
+        {
+            StreamFile file;
+            if ( !file.open( tempFilePath, "wb" ) ) {
+                ERROR_LOG( "Unable to create the ICN cache file " << tempFilePath )
+                return;
+            }
+
+            file.putLE32( cacheFileMagic );
+            file.putLE32( cacheFileFormatVersion );
+            file.putLE32( _key );
+            file.putLE32( static_cast<uint32_t>( records.size() ) );
+            file.putLE32( calculateCRC32( index.data(), index.size() ) );
+            file.putRaw( index.data(), index.size() );
+
+            for ( const auto & [icnId, data] : records ) {
+                file.putRaw( data.first, data.second );
+            }
+
+            if ( file.fail() ) {
+                ERROR_LOG( "Unable to write the ICN cache file " << tempFilePath )
+                file.close();
+                System::Unlink( tempFilePath );
+                return;
+            }
+        }
+
+        // The old cache file must not be in use while it is being replaced.
+        _unload();
+
+        if ( !System::Rename( tempFilePath, _filePath ) ) {
+            ERROR_LOG( "Unable to replace the ICN cache file " << _filePath )
+            System::Unlink( tempFilePath );
+        }
+
+        _load();
+
+        DEBUG_LOG( DBG_ENGINE, DBG_INFO, "ICN cache file " << _filePath << " has been saved with " << _records.size() << " records" )
+    }
+
+    bool ICNCache::read( const int icnId, std::vector<std::pair<int, std::vector<Sprite>>> & icnSprites ) const
+    {
+        auto iter = _records.find( icnId );
+        if ( iter == _records.end() ) {
+            return false;
+        }
+
+        const Record & record = iter->second;
+        if ( calculateCRC32( _data + record.offset, record.size ) != record.checksum ) {
+            ERROR_LOG( "ICN cache record for ICN " << icnId << " is corrupted." )
+            return false;
+        }
+
+        ROStreamBuf buffer( _data + record.offset, record.size );
+
+        const uint32_t icnCount = buffer.getLE32();
+        if ( icnCount > buffer.size() / ( sizeof( uint32_t ) * 2 ) ) {
+            return false;
+        }
+
+        std::vector<std::pair<int, std::vector<Sprite>>> output( icnCount );
+
+        for ( auto & [id, sprites] : output ) {
+            id = static_cast<int>( buffer.getLE32() );
+
+            const uint32_t spriteCount = buffer.getLE32();
+            if ( spriteCount > buffer.size() / spriteHeaderSize ) {
+                return false;
+            }
+
+            sprites.resize( spriteCount );
+
+            for ( Sprite & sprite : sprites ) {
+                const int32_t width = static_cast<int32_t>( buffer.getLE32() );
+                const int32_t height = static_cast<int32_t>( buffer.getLE32() );
+                const int32_t x = static_cast<int32_t>( buffer.getLE32() );
+                const int32_t y = static_cast<int32_t>( buffer.getLE32() );
+                const bool isSingleLayer = ( buffer.get() != 0 );
+
+                if ( width < 0 || height < 0 ) {
+                    return false;
+                }
+
+                sprite.resize( width, height );
+                sprite.setPosition( x, y );
+
+                if ( isSingleLayer ) {
+                    sprite._disableTransformLayer();
+                }
+
+                if ( sprite.empty() ) {
+                    continue;
+                }
+
+                const size_t layerSize = static_cast<size_t>( width ) * height;
+                const auto [data, dataSize] = buffer.getRawView( layerSize * 2 );
+                if ( dataSize != layerSize * 2 ) {
+                    return false;
+                }
+
+                // Both layers are stored in the image one after another.
+                memcpy( sprite.image(), data, dataSize );
+            }
+        }
+
+        if ( buffer.fail() ) {
+            return false;
+        }
+
+        icnSprites = std::move( output );
+
+        return true;
+    }
+
+    void ICNCache::add( const int icnId, const std::vector<std::pair<int, std::vector<uint8_t>>> & icnSprites )
+    {
+        if ( !isOpen() ) {
+            return;
+        }
+
+        size_t recordSize = sizeof( uint32_t );
+        for ( const auto & [id, data] : icnSprites ) {
+            recordSize += sizeof( uint32_t ) + data.size();
+        }
+
+        if ( recordSize > maxRecordSize ) {
+            ERROR_LOG( "ICN cache record for ICN " << icnId << " is too big: " << recordSize << " bytes." )
+            return;
+        }
+
+        if ( _size + _newRecordsSize + recordSize > maxCacheFileSize ) {
+            return;
+        }
+
+        RWStreamBuf buffer( recordSize );
+        buffer.putLE32( static_cast<uint32_t>( icnSprites.size() ) );
+
+        for ( const auto & [id, data] : icnSprites ) {
+            buffer.putLE32( static_cast<uint32_t>( id ) );
+            buffer.putRaw( data.data(), data.size() );
+        }
+
+        std::vector<uint8_t> & record = _newRecords[icnId];
+        _newRecordsSize = _newRecordsSize - record.size() + buffer.size();
+
+        record.assign( buffer.data(), buffer.data() + buffer.size() );
+    }
+
+    std::vector<uint8_t> ICNCache::serializeSprites( const std::vector<Sprite> & sprites )
+    {
+        size_t totalSize = sizeof( uint32_t );
+        for ( const Sprite & sprite : sprites ) {
+            totalSize += spriteHeaderSize + static_cast<size_t>( sprite.width() ) * sprite.height() * 2;
+        }
+
+        RWStreamBuf buffer( totalSize );
+        buffer.putLE32( static_cast<uint32_t>( sprites.size() ) );
+
+        for ( const Sprite & sprite : sprites ) {
+            buffer.putLE32( static_cast<uint32_t>( sprite.width() ) );
+            buffer.putLE32( static_cast<uint32_t>( sprite.height() ) );
+            buffer.putLE32( static_cast<uint32_t>( sprite.x() ) );
+            buffer.putLE32( static_cast<uint32_t>( sprite.y() ) );
+            buffer.put( sprite.singleLayer() ? 1 : 0 );
+
+            if ( !sprite.empty() ) {
+                buffer.putRaw( sprite.image(), static_cast<size_t>( sprite.width() ) * sprite.height() * 2 );
+            }
+        }
+
+        return { buffer.data(), buffer.data() + buffer.size() };
+    }
+
+    void ICNCache::_load()
+    {
+        assert( _data == nullptr && _records.empty() );
+
+        if ( !System::IsFile( _filePath ) ) {
+            return;
+        }
+
+        if ( _mappedFile.open( _filePath ) ) {
+            _data = _mappedFile.data();
+            _size = _mappedFile.size();
+        }
+        else {
+            StreamFile file;
+            if ( !file.open( _filePath, "rb" ) ) {
+                return;
+            }
+
+            _fileContent = file.getRaw( 0 );
+            _data = _fileContent.data();
+            _size = _fileContent.size();
+        }
+
+        ROStreamBuf header( _data, _size );
+
+        const uint32_t magic = header.getLE32();
+        const uint32_t formatVersion = header.getLE32();
+        const uint32_t key = header.getLE32();
+        const size_t recordCount = header.getLE32();
+        const uint32_t indexChecksum = header.getLE32();
+
+        if ( header.fail() || magic != cacheFileMagic || formatVersion != cacheFileFormatVersion || key != _key ) {
+            // The cache file was created by a different version of the engine or for different resources. It will be overwritten.
+            DEBUG_LOG( DBG_ENGINE, DBG_INFO, "ICN cache file " << _filePath << " is outdated." )
+            _unload();
+            return;
+        }
+
+        const auto [indexData, indexSize] = header.getRawView( recordCount * cacheFileIndexEntrySize );
+        if ( indexSize != recordCount * cacheFileIndexEntrySize || calculateCRC32( indexData, indexSize ) != indexChecksum ) {
+            ERROR_LOG( "ICN cache file " << _filePath << " is corrupted." )
+            _unload();
+            return;
+        }
+
+        ROStreamBuf index( indexData, indexSize );
+
+        for ( size_t i = 0; i < recordCount; ++i ) {
+            const int icnId = static_cast<int>( index.getLE32() );
+
+            Record record;
+            record.offset = index.getLE32();
+            record.size = index.getLE32();
+            record.checksum = index.getLE32();
+
+            if ( record.offset > _size || record.size > _size - record.offset || record.size > maxRecordSize ) {
+                ERROR_LOG( "ICN cache file " << _filePath << " is corrupted." )
+                _unload();
+                return;
+            }
+
+            _records.try_emplace( icnId, record );
+        }
+    }
+
+    void ICNCache::_unload()
+    {
+        _records.clear();
+        _newRecords.clear();
+        _newRecordsSize = 0;
+
+        _data = nullptr;
+        _size = 0;
+
+        _mappedFile.close();
+        _fileContent.clear();
+    }
+}
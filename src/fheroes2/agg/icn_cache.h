@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "agg_file.h"
+
+namespace fheroes2
+{
+    class Sprite;
+
+    // Persistent storage of ICNs which are generated or modified by the engine. The storage file is memory mapped and every record
+    // is protected by a checksum: a missing, outdated or corrupted record is ignored so the ICN is generated again.
+    //
+    // A record of an ICN holds sprites of this ICN and of all other ICNs which were created or changed while generating it.
+    class ICNCache
+    {
+    public:
+        ICNCache() = default;
+        ICNCache( const ICNCache & ) = delete;
+
+        ~ICNCache() = default;
+
+        ICNCache & operator=( const ICNCache & ) = delete;
+
+        // Switches to the cache file with the given path. Records of this file are used only if the file was created with the same key.
+        // New records of the previously opened file are saved before switching.
+        void open( const std::string & filePath, const uint32_t key );
+
+        // Writes all new records to the cache file.
+        void save();
+
+        // Returns true and fills 'icnSprites' with pairs of ICN ID and ICN sprites if a valid record exists for the given ICN.
+        bool read( const int icnId, std::vector<std::pair<int, std::vector<Sprite>>> & icnSprites ) const;
+
+        // Adds a record for the given ICN. 'icnSprites' contains pairs of ICN ID and serialized ICN sprites.
+        void add( const int icnId, const std::vector<std::pair<int, std::vector<uint8_t>>> & icnSprites );
+
+        bool isOpen() const
+        {
+            return !_filePath.empty();
+        }
+
+        static std::vector<uint8_t> serializeSprites( const std::vector<Sprite> & sprites );
+
+    private:
+        struct Record
+        {
+            uint32_t offset{ 0 };
+            uint32_t size{ 0 };
+            uint32_t checksum{ 0 };
+        };
+
+        std::string _filePath;
+        uint32_t _key{ 0 };
+
+        MemoryMappedFile _mappedFile;
+
+        // The content of the cache file if memory mapping is not supported.
+        std::vector<uint8_t> _fileContent;
+
+        const uint8_t * _data{ nullptr };
+        size_t _size{ 0 };
+
+        // Records stored in the cache file.
+        std::map<int, Record> _records;
+
+        // Records which have been added after the cache file was opened.
+        std::map<int, std::vector<uint8_t>> _newRecords;
+
+        size_t _newRecordsSize{ 0 };
+
+        void _load();
+        void _unload();
+    };
+}
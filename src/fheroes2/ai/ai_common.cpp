@@ -39,7 +39,9 @@
 #include "color.h"
 #include "difficulty.h"
 #include "game.h"
+#include "game_interface.h"
 #include "heroes.h"
+#include "interface_status.h"
 #include "kingdom.h"
 #include "logging.h"
 #include "maps.h"
@@ -417,3 +419,21 @@ bool AI::isUltimateArtifactAvailableToHero( const UltimateArtifact & art, const
 
     return Maps::isValidAbsIndex( idx ) && world.getTile( idx ).isSuitableForUltimateArtifact();
 }
+
+void AI::drawTurnProgress( const uint32_t progressValue )
+{
+    if ( Game::isHeadlessMode() ) {
+        return;
+    }
+
+    Interface::AdventureMap::Get().getStatusPanel().drawAITurnProgress( progressValue );
+}
+
+void AI::resetTurnProgress()
+{
+    if ( Game::isHeadlessMode() ) {
+        return;
+    }
+
+    Interface::AdventureMap::Get().getStatusPanel().resetAITurnProgress();
+}
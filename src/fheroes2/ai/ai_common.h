@@ -72,4 +72,11 @@ namespace AI
     // the Ultimate Artifact is considered available to the given hero if this hero knows its exact location and there
     // is a free slot in the hero's artifact bag. See the implementation for details.
     bool isUltimateArtifactAvailableToHero( const UltimateArtifact & art, const Heroes & hero );
+
+    // Updates the turn progress indicator on the status panel of the adventure map. The adventure map is not used at all
+    // in the headless mode, so nothing is drawn in this mode.
+    void drawTurnProgress( const uint32_t progressValue );
+
+    // Resets the turn progress indicator so that the next turn starts with an empty indicator.
+    void resetTurnProgress();
 }
@@ -432,8 +432,10 @@ namespace
 
             const Battle::Result res = Battle::Loader( hero.GetArmy(), army, dstIndex );
 
-            // Human controlled castle or hero in this castle was in the battle. Update icons.
-            Interface::AdventureMap::Get().renderWithFadeInOrPlanRender( Interface::REDRAW_ICONS );
+            if ( !Game::isHeadlessMode() ) {
+                // Human controlled castle or hero in this castle was in the battle. Update icons.
+                Interface::AdventureMap::Get().renderWithFadeInOrPlanRender( Interface::REDRAW_ICONS );
+            }
 
             castle->ActionAfterBattle( res.AttackerWins() );
 
@@ -521,8 +523,10 @@ namespace
 
         const Battle::Result res = Battle::Loader( hero.GetArmy(), otherHero->GetArmy(), dstIndex );
 
-        // Human controlled hero could be in the battle. Update icons.
-        Interface::AdventureMap::Get().renderWithFadeInOrPlanRender( Interface::REDRAW_HEROES );
+        if ( !Game::isHeadlessMode() ) {
+            // Human controlled hero could be in the battle. Update icons.
+            Interface::AdventureMap::Get().renderWithFadeInOrPlanRender( Interface::REDRAW_HEROES );
+        }
 
         // The defender was defeated
         if ( !res.DefenderWins() ) {
@@ -2185,6 +2189,28 @@ fheroes2::GameMode AI::HeroesMove( Heroes & hero )
 
     hero.SetMove( true );
 
+    if ( Game::isHeadlessMode() ) {
+        // There is nothing to render and no events to process, so the hero makes all the steps of his path at once.
+        while ( hero.isActive() && hero.isMoveEnabled() ) {
+            hero.resetHeroSprite();
+            hero.Move( true );
+
+            if ( hero.isAction() ) {
+                hero.ResetAction();
+
+                // Check if the game is over after the hero's action.
+                const fheroes2::GameMode gameState = GameOver::Result::Get().checkGameOver();
+                if ( gameState != fheroes2::GameMode::CANCEL ) {
+                    return gameState;
+                }
+            }
+        }
+
+        hero.SetMove( false );
+
+        return fheroes2::GameMode::END_TURN;
+    }
+
     Interface::AdventureMap & adventureMapInterface = Interface::AdventureMap::Get();
     Interface::GameArea & gameArea = adventureMapInterface.getGameArea();
 
@@ -2380,11 +2406,10 @@ int32_t AI::HeroesCastSummonBoat( Heroes & hero, const int32_t boatDestinationIn
 
     const int heroColor = hero.GetColor();
 
-    Interface::GameArea & gameArea = Interface::AdventureMap::Get().getGameArea();
-
     Maps::Tile & tileSource = world.getTile( boatSource );
 
     if ( AIIsShowAnimationForTile( tileSource, AIGetAllianceColors() ) ) {
+        Interface::GameArea & gameArea = Interface::AdventureMap::Get().getGameArea();
         gameArea.SetCenter( Maps::GetPoint( boatSource ) );
         gameArea.runSingleObjectAnimation( std::make_shared<Interface::ObjectFadingOutInfo>( tileSource.getMainObjectPart()._uid, boatSource, MP2::OBJ_BOAT ) );
     }
@@ -2399,6 +2424,7 @@ int32_t AI::HeroesCastSummonBoat( Heroes & hero, const int32_t boatDestinationIn
     tileSource.resetBoatOwnerColor();
 
     if ( AIIsShowAnimationForTile( tileDest, AIGetAllianceColors() ) ) {
+        Interface::GameArea & gameArea = Interface::AdventureMap::Get().getGameArea();
         gameArea.SetCenter( Maps::GetPoint( boatDestinationIndex ) );
         gameArea.runSingleObjectAnimation( std::make_shared<Interface::ObjectFadingInInfo>( tileDest.getMainObjectPart()._uid, boatDestinationIndex, MP2::OBJ_BOAT ) );
     }
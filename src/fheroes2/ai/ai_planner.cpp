@@ -24,6 +24,7 @@
 #include <cassert>
 #include <cstdint>
 #include <map>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -47,6 +48,13 @@ AI::Planner & AI::Planner::Get()
 void AI::Planner::resetPathfinder()
 {
     _pathfinder.reset();
+    for ( const auto & pathfinder : _enemyArmyPathfinders ) {
+        pathfinder->reset();
+    }
+
+    for ( const auto & pathfinder : _workerPathfinders ) {
+        pathfinder->reset();
+    }
 }
 
 void AI::Planner::revealFog( const Maps::Tile & tile, const Kingdom & kingdom )
@@ -78,16 +86,26 @@ void AI::Planner::revealFog( const Maps::Tile & tile, const Kingdom & kingdom )
 
 double AI::Planner::getTileArmyStrength( const Maps::Tile & tile )
 {
-    const auto [iter, inserted] = _tileArmyStrengthValues.try_emplace( tile.GetIndex(), 0.0 );
-    if ( inserted ) {
-        // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-        static Army tileArmy;
-        tileArmy.setFromTile( tile );
+    // This method can be called from several threads at the same time when targets for heroes are evaluated in parallel
+    {
+        const std::scoped_lock<std::mutex> lock( _tileArmyStrengthValuesMutex );
 
-        iter->second = tileArmy.GetStrength();
+        if ( const auto iter = _tileArmyStrengthValues.find( tile.GetIndex() ); iter != _tileArmyStrengthValues.end() ) {
+            return iter->second;
+        }
     }
 
-    return iter->second;
+    // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
+    thread_local Army tileArmy;
+    tileArmy.setFromTile( tile );
+
+    const double strength = tileArmy.GetStrength();
+
+    const std::scoped_lock<std::mutex> lock( _tileArmyStrengthValuesMutex );
+
+    _tileArmyStrengthValues.try_emplace( tile.GetIndex(), strength );
+
+    return strength;
 }
 
 double AI::Planner::getResourcePriorityModifier( const int resource, const bool isMine ) const
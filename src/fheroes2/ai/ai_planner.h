@@ -23,6 +23,9 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <utility>
@@ -209,14 +212,20 @@ namespace AI
 
         std::vector<AICastle> getSortedCastleList( const VecCastles & castles, const std::set<int> & castlesInDanger );
 
-        int getPriorityTarget( Heroes & hero, double & maxPriority );
+        // If the hero is a courier, then the main target of this courier can be passed as 'courierMainTarget' if it has already been calculated.
+        int getPriorityTarget( Heroes & hero, double & maxPriority, AIWorldPathfinder & pathfinder, const std::optional<int> courierMainTarget = {} );
+
+        // Evaluates priority targets for the given heroes using the given number of threads. Returns pairs consisting of the target tile index
+        // and its priority for each hero in the same order as the heroes are listed. The result is identical to the result of sequential calls
+        // of getPriorityTarget() for these heroes.
+        std::vector<std::pair<int, double>> getPriorityTargets( const std::vector<Heroes *> & heroes, const uint32_t threadCount );
 
         double getGeneralObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
         double getFighterObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
         double getCourierObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
         double getScoutObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
 
-        int getCourierMainTarget( const Heroes & hero, const double lowestPossibleValue );
+        int getCourierMainTarget( const Heroes & hero, const double lowestPossibleValue, AIWorldPathfinder & pathfinder );
 
         double getResourcePriorityModifier( const int resource, const bool isMine ) const;
         double getFundsValueBasedOnPriority( const Funds & funds ) const;
@@ -238,6 +247,13 @@ namespace AI
         // IMPORTANT!!! Do not call this method directly. Use other methods which call it internally.
         bool updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy );
 
+        // Removes the enemy army located on the given tile (if any) along with all the cached data associated with it
+        void removeEnemyArmy( const int32_t tileIndex );
+
+        // Returns the distances from the given enemy hero to all tiles of the map calculated using the "optimistic" pathfinder settings for
+        // this hero. The result is cached until the information about the army located on the corresponding tile is updated.
+        const std::vector<uint32_t> & getEnemyArmyDistances( const EnemyArmy & enemyArmy );
+
         void removePriorityAttackTarget( const int32_t tileIndex );
         void updatePriorityAttackTarget( const Kingdom & kingdom, const Maps::Tile & tile );
 
@@ -262,15 +278,31 @@ namespace AI
         std::unordered_map<int32_t, PriorityTask> _priorityTargets;
         std::unordered_map<int32_t, EnemyArmy> _enemyArmies;
 
+        // Distances from enemy heroes to the map tiles are used to estimate threats for each AI hero, but their calculation requires a full map
+        // sweep by the pathfinder, so they are calculated once per enemy hero during the turn and shared by all AI heroes of the kingdom. It is
+        // important to remove the corresponding entry after updating the information about the enemy army.
+        std::unordered_map<int32_t, std::vector<uint32_t>> _enemyArmyDistances;
+        std::mutex _enemyArmyDistancesMutex;
+
         // Strength of the armies guarding the tiles (neutral monsters, guardians of dwellings, and so on) is constant for AI
         // during the same turn, but its calculation is a heavy operation, so it needs to be cached to speed up estimations.
         // It is important to update this cache after performing an action on the corresponding tile.
         std::unordered_map<int32_t, double> _tileArmyStrengthValues;
+        std::mutex _tileArmyStrengthValuesMutex;
 
         std::vector<RegionStats> _regions;
 
         std::array<BudgetEntry, 7> _budget = { Resource::WOOD, Resource::MERCURY, Resource::ORE, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD };
 
         AIWorldPathfinder _pathfinder;
+
+        // Separate pathfinder instances are used to calculate distances for enemy heroes in order to keep the cache of the main pathfinder intact.
+        // These distances can be calculated by several threads at the same time, so this container holds the instances which are not in use at
+        // the moment. Access to it is protected by _enemyArmyDistancesMutex.
+        std::vector<std::unique_ptr<AIWorldPathfinder>> _enemyArmyPathfinders;
+
+        // Additional pathfinder instances used by worker threads to evaluate targets for several heroes in parallel (the main pathfinder is
+        // used by the calling thread)
+        std::vector<std::unique_ptr<AIWorldPathfinder>> _workerPathfinders;
     };
 }
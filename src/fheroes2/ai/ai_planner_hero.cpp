@@ -26,6 +26,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -46,14 +47,12 @@
 #include "difficulty.h"
 #include "direction.h"
 #include "game.h"
-#include "game_interface.h"
 #include "game_mode.h"
 #include "game_over.h"
 #include "game_static.h"
 #include "ground.h"
 #include "heroes.h"
 #include "heroes_base.h"
-#include "interface_status.h"
 #include "kingdom.h"
 #include "logging.h"
 #include "luck.h"
@@ -74,6 +73,7 @@
 #include "settings.h"
 #include "skill.h"
 #include "spell.h"
+#include "thread.h"
 #include "visit.h"
 #include "world.h"
 #include "world_pathfinding.h"
@@ -146,6 +146,12 @@ namespace
         return ( regularMovementDist == 0 || dimensionDoorDist < regularMovementDist / 2 );
     }
 
+    // Returns the value which is guaranteed to be lower than the value of any target on the map
+    double getLowestPossibleTargetValue()
+    {
+        return -1.0 * Maps::Ground::slowestMovePenalty * world.getSize();
+    }
+
     // Returns a pair consisting of a distance and a boolean value set to true if this distance was calculated
     // for the case of movement using the Dimension Door spell, otherwise this value is set to false
     std::pair<uint32_t, bool> getDistanceToTile( AIWorldPathfinder & pathfinder, const int32_t index )
@@ -2071,7 +2077,7 @@ double AI::Planner::getObjectValue( const Heroes & hero, const int32_t index, co
     return 0;
 }
 
-int AI::Planner::getCourierMainTarget( const Heroes & hero, const double lowestPossibleValue )
+int AI::Planner::getCourierMainTarget( const Heroes & hero, const double lowestPossibleValue, AIWorldPathfinder & pathfinder )
 {
     assert( hero.getAIRole() == Heroes::Role::COURIER );
 
@@ -2095,7 +2101,7 @@ int AI::Planner::getCourierMainTarget( const Heroes & hero, const double lowestP
 
         const int currentHeroIndex = otherHero->GetIndex();
 
-        const auto [dist, dummy] = getDistanceToTile( _pathfinder, currentHeroIndex );
+        const auto [dist, dummy] = getDistanceToTile( pathfinder, currentHeroIndex );
         if ( dist == 0 || hero.hasMetWithHero( otherHero->GetID() ) ) {
             continue;
         }
@@ -2130,7 +2136,7 @@ int AI::Planner::getCourierMainTarget( const Heroes & hero, const double lowestP
 
         const int currentCastleIndex = castle->GetIndex();
 
-        const auto [dist, dummy] = getDistanceToTile( _pathfinder, currentCastleIndex );
+        const auto [dist, dummy] = getDistanceToTile( pathfinder, currentCastleIndex );
         if ( dist == 0 ) {
             continue;
         }
@@ -2160,11 +2166,11 @@ int AI::Planner::getCourierMainTarget( const Heroes & hero, const double lowestP
     return targetIndex;
 }
 
-int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
+int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority, AIWorldPathfinder & pathfinder, const std::optional<int> courierMainTarget )
 {
     DEBUG_LOG( DBG_AI, DBG_INFO, "Find Adventure Map target for hero " << hero.GetName() << " at current position " << hero.GetIndex() )
 
-    const double lowestPossibleValue = -1.0 * Maps::Ground::slowestMovePenalty * world.getSize();
+    const double lowestPossibleValue = getLowestPossibleTargetValue();
 
     int priorityTarget = -1;
     maxPriority = lowestPossibleValue;
@@ -2190,12 +2196,6 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
     const std::vector<double> enemyThreatPenalties = [this, &hero = std::as_const( hero )]() {
         std::vector<double> result( world.getSize(), 0.0 );
 
-        const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
-
-        // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
-        _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
-        _pathfinder.setSpellPointsReserveRatio( 0.0 );
-
         const double heroStrength = hero.GetArmy().GetStrength();
 
         for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
@@ -2222,16 +2222,15 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             const bool useRoughEstimate = ( Maps::GetApproximateDistance( hero.GetIndex(), enemyArmy.index ) * Maps::Ground::fastestMovePenalty
                                             > hero.GetMovePoints() + enemyArmyMovePointsThreshold );
 
-            if ( !useRoughEstimate ) {
-                // Pre-cache the pathfinder database for the enemy hero
-                _pathfinder.reEvaluateIfNeeded( *enemyArmy.hero );
-            }
+            // Distances for the enemy hero are shared by all heroes of the kingdom, so they are calculated only once during the turn
+            const std::vector<uint32_t> * enemyArmyDistances = useRoughEstimate ? nullptr : &getEnemyArmyDistances( enemyArmy );
 
             for ( size_t i = 0; i < result.size(); ++i ) {
                 const int32_t tileIdx = static_cast<int32_t>( i );
                 assert( Maps::isValidAbsIndex( tileIdx ) );
 
-                const auto [distToTile, isTileConsideredSafe] = [this, enemyArmyIdx = enemyArmy.index, enemyArmyMovePointsThreshold, useRoughEstimate, tileIdx]() {
+                const auto [distToTile, isTileConsideredSafe] = [enemyArmyIdx = enemyArmy.index, enemyArmyDistances, enemyArmyMovePointsThreshold, useRoughEstimate,
+                                                                 tileIdx]() {
                     // The tile on which the enemy hero is located is always considered unsafe
                     if ( tileIdx == enemyArmyIdx ) {
                         return std::make_pair( static_cast<uint32_t>( 0 ), false );
@@ -2246,7 +2245,9 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
                         return std::make_pair( dist, dist > enemyArmyMovePointsThreshold );
                     }
 
-                    const uint32_t dist = _pathfinder.getDistance( tileIdx );
+                    assert( enemyArmyDistances != nullptr && static_cast<size_t>( tileIdx ) < enemyArmyDistances->size() );
+
+                    const uint32_t dist = ( *enemyArmyDistances )[tileIdx];
 
                     // When using an accurate estimate, a tile is considered safe if the enemy hero does not have access to it (in particular, if it is hidden from
                     // him in the fog) or he cannot reach it within one turn. The potential ability of the enemy hero to use spells to move to this tile (for example,
@@ -2268,16 +2269,16 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
     }();
 
     // Pre-cache the pathfinder database for our hero
-    _pathfinder.reEvaluateIfNeeded( hero );
+    pathfinder.reEvaluateIfNeeded( hero );
 
-    ObjectValidator objectValidator( hero, _pathfinder, *this );
+    ObjectValidator objectValidator( hero, pathfinder, *this );
     ObjectValueStorage valueStorage( hero, *this, lowestPossibleValue );
 
-    const auto getObjectValue = [this, &hero = std::as_const( hero ), &enemyThreatPenalties, &objectValidator,
+    const auto getObjectValue = [this, &hero = std::as_const( hero ), &pathfinder, &enemyThreatPenalties, &objectValidator,
                                  &valueStorage]( const int destination, uint32_t & distance, double & value, const MP2::MapObjectType type, const bool isDimensionDoor ) {
         // Dimension door path does not include any objects on the way.
         if ( !isDimensionDoor ) {
-            for ( const IndexObject & pair : _pathfinder.getObjectsOnTheWay( destination ) ) {
+            for ( const IndexObject & pair : pathfinder.getObjectsOnTheWay( destination ) ) {
                 if ( !objectValidator.isValid( pair.first ) ) {
                     continue;
                 }
@@ -2325,7 +2326,8 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
 
     // Set baseline target if it's a special role
     if ( hero.getAIRole() == Heroes::Role::COURIER ) {
-        if ( const int courierTarget = getCourierMainTarget( hero, lowestPossibleValue ); courierTarget != -1 ) {
+        const int courierTarget = courierMainTarget ? *courierMainTarget : getCourierMainTarget( hero, lowestPossibleValue, pathfinder );
+        if ( courierTarget != -1 ) {
             // Anything with positive value can override the courier's main task (i.e. castle or mine capture on the way)
             priorityTarget = courierTarget;
             maxPriority = 0;
@@ -2346,7 +2348,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             continue;
         }
 
-        auto [dist, useDimensionDoor] = getDistanceToTile( _pathfinder, idx );
+        auto [dist, useDimensionDoor] = getDistanceToTile( pathfinder, idx );
         if ( dist == 0 ) {
             continue;
         }
@@ -2372,7 +2374,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
 
         // If there is an action object on this tile (e.g. a hero), then this tile should be ignored, and that object should have already been considered
         if ( _mapActionObjects.count( idx ) == 0 ) {
-            auto [dist, useDimensionDoor] = getDistanceToTile( _pathfinder, idx );
+            auto [dist, useDimensionDoor] = getDistanceToTile( pathfinder, idx );
 
             if ( dist > 0 ) {
                 double value = ( isFindUltimateArtifactVictoryCondition() ? 3000.0 : 1500.0 ) * art.getArtifactValue();
@@ -2392,8 +2394,8 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
     }
 
     // TODO: add logic to check fog discovery based on Dimension Door distance, not the nearest tile.
-    if ( const auto [idx, isTerritoryExpansion] = _pathfinder.getFogDiscoveryTile( hero ); Maps::isValidAbsIndex( idx ) ) {
-        auto [dist, useDimensionDoor] = getDistanceToTile( _pathfinder, idx );
+    if ( const auto [idx, isTerritoryExpansion] = pathfinder.getFogDiscoveryTile( hero ); Maps::isValidAbsIndex( idx ) ) {
+        auto [dist, useDimensionDoor] = getDistanceToTile( pathfinder, idx );
         assert( dist > 0 );
 
         double value = getFogDiscoveryValue( hero );
@@ -2445,6 +2447,76 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
     return priorityTarget;
 }
 
+std::vector<std::pair<int, double>> AI::Planner::getPriorityTargets( const std::vector<Heroes *> & heroes, const uint32_t threadCount )
+{
+    assert( threadCount > 1 );
+
+    while ( _workerPathfinders.size() + 1 < threadCount ) {
+        _workerPathfinders.emplace_back( std::make_unique<AIWorldPathfinder>() );
+    }
+
+    // All pathfinders should use the same settings as the main one
+    for ( const auto & pathfinder : _workerPathfinders ) {
+        pathfinder->setMinimalArmyStrengthAdvantage( _pathfinder.getMinimalArmyStrengthAdvantage() );
+        pathfinder->setSpellPointsReserveRatio( _pathfinder.getSpellPointsReserveRatio() );
+    }
+
+    const double lowestPossibleValue = getLowestPossibleTargetValue();
+
+    std::vector<std::pair<int, double>> result( heroes.size(), { -1, -1.0 } );
+    // std::vector<bool> cannot be used here because its elements cannot be safely modified from different threads
+    std::vector<uint8_t> isCourierRoleObsolete( heroes.size(), 0 );
+
+    size_t firstHeroIdx = 0;
+
+    const auto evaluateTarget = [this, &heroes, &result, &isCourierRoleObsolete, &firstHeroIdx, lowestPossibleValue]( const size_t idx, const uint32_t threadIdx ) {
+        const size_t heroIdx = firstHeroIdx + idx;
+        assert( heroes[heroIdx] != nullptr );
+
+        Heroes & hero = *heroes[heroIdx];
+        AIWorldPathfinder & pathfinder = ( threadIdx == 0 ) ? _pathfinder : *_workerPathfinders[threadIdx - 1];
+
+        // Heroes' roles should not be changed while targets are being evaluated in parallel, because these roles are taken into account when
+        // evaluating targets for other heroes
+        std::optional<int> courierMainTarget;
+
+        if ( hero.getAIRole() == Heroes::Role::COURIER ) {
+            pathfinder.reEvaluateIfNeeded( hero );
+
+            courierMainTarget = getCourierMainTarget( hero, lowestPossibleValue, pathfinder );
+            if ( *courierMainTarget == -1 ) {
+                isCourierRoleObsolete[heroIdx] = 1;
+
+                return;
+            }
+        }
+
+        isCourierRoleObsolete[heroIdx] = 0;
+
+        auto & [targetIndex, priority] = result[heroIdx];
+
+        priority = -1;
+        targetIndex = getPriorityTarget( hero, priority, pathfinder, courierMainTarget );
+    };
+
+    while ( firstHeroIdx < heroes.size() ) {
+        MultiThreading::parallelFor( heroes.size() - firstHeroIdx, threadCount, evaluateTarget );
+
+        const auto iter = std::find( isCourierRoleObsolete.begin() + static_cast<std::ptrdiff_t>( firstHeroIdx ), isCourierRoleObsolete.end(), 1 );
+        if ( iter == isCourierRoleObsolete.end() ) {
+            break;
+        }
+
+        // When targets are evaluated sequentially, the role of this hero is changed during the evaluation, and this affects the evaluation of
+        // targets of this hero and all the heroes following him. Change the role and re-evaluate targets for these heroes.
+        firstHeroIdx = static_cast<size_t>( iter - isCourierRoleObsolete.begin() );
+
+        heroes[firstHeroIdx]->setAIRole( Heroes::Role::HUNTER );
+    }
+
+    return result;
+}
+
 void AI::Planner::updatePriorityTargets( Heroes & hero, int32_t tileIndex, const MP2::MapObjectType objectType )
 {
     if ( objectType != MP2::OBJ_CASTLE && objectType != MP2::OBJ_HERO ) {
@@ -2459,12 +2531,12 @@ void AI::Planner::updatePriorityTargets( Heroes & hero, int32_t tileIndex, const
                 // How is it possible?
                 assert( 0 );
 
-                _enemyArmies.erase( tileIndex );
+                removeEnemyArmy( tileIndex );
                 return;
             }
 
             if ( hero.isFriends( castle->GetColor() ) ) {
-                _enemyArmies.erase( tileIndex );
+                removeEnemyArmy( tileIndex );
 
                 updatePriorityForCastle( *castle );
             }
@@ -2486,7 +2558,7 @@ void AI::Planner::updatePriorityTargets( Heroes & hero, int32_t tileIndex, const
                     updateCastle();
                 }
                 else {
-                    _enemyArmies.erase( tileIndex );
+                    removeEnemyArmy( tileIndex );
                 }
 
                 return;
@@ -2763,8 +2835,6 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
         addHeroToMove( hero, availableHeroes );
     }
 
-    Interface::StatusPanel & status = Interface::AdventureMap::Get().getStatusPanel();
-
     uint32_t heroesToMoveTotalCount = static_cast<uint32_t>( availableHeroes.size() );
     uint32_t startProgressValue = currentProgressValue;
 
@@ -2777,6 +2847,16 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
 
     uint32_t turnProgressScale = 4 * ( endProgressValue - startProgressValue );
 
+    // Targets for several heroes can be evaluated in parallel, each thread uses its own pathfinder
+    const uint32_t workerThreads = [] {
+        const int threads = Settings::Get().getAIWorkerThreads();
+        if ( threads <= 0 ) {
+            return MultiThreading::getMaxParallelThreads();
+        }
+
+        return static_cast<uint32_t>( threads );
+    }();
+
     while ( !availableHeroes.empty() ) {
         const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
 
@@ -2784,6 +2864,9 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
         int bestTargetIndex = -1;
 
         {
+            // The game state is not changed while targets are evaluated, so army strength values can be reused.
+            const Army::StrengthCachingScope strengthCachingScope;
+
             const bool isLosingGame = bestHero->isLosingGame();
 
             static const std::vector<std::pair<double, double>> commonPathfinderConfigurations{ { ARMY_ADVANTAGE_LARGE, 0.5 },
@@ -2797,18 +2880,34 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
 
                 double maxPriority = 0;
 
-                for ( Heroes * hero : availableHeroes ) {
-                    double priority = -1;
-                    const int targetIndex = getPriorityTarget( *hero, priority );
-
+                const auto updateBestTarget = [&maxPriority, &bestTargetIndex, &bestHero]( Heroes * hero, const int targetIndex, const double priority ) {
                     if ( targetIndex != -1 && ( priority > maxPriority || bestTargetIndex == -1 ) ) {
                         maxPriority = priority;
                         bestTargetIndex = targetIndex;
                         bestHero = hero;
                     }
+                };
+
+                if ( workerThreads > 1 && availableHeroes.size() > 1 ) {
+                    const std::vector<std::pair<int, double>> targets = getPriorityTargets( availableHeroes, workerThreads );
+                    assert( targets.size() == availableHeroes.size() );
 
-                    // This loop may take many time for computations, so pump the event queue and update the animation of the hourglass grains.
-                    status.drawAITurnProgress( currentProgressValue );
+                    for ( size_t i = 0; i < availableHeroes.size(); ++i ) {
+                        updateBestTarget( availableHeroes[i], targets[i].first, targets[i].second );
+                    }
+
+                    drawTurnProgress( currentProgressValue );
+                }
+                else {
+                    for ( Heroes * hero : availableHeroes ) {
+                        double priority = -1;
+                        const int targetIndex = getPriorityTarget( *hero, priority, _pathfinder );
+
+                        updateBestTarget( hero, targetIndex, priority );
+
+                        // This loop may take many time for computations, so pump the event queue and update the animation of the hourglass grains.
+                        drawTurnProgress( currentProgressValue );
+                    }
                 }
 
                 if ( bestTargetIndex != -1 ) {
@@ -2823,7 +2922,7 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
                                          ( turnProgressScale * ( heroesToMoveTotalCount - static_cast<uint32_t>( availableHeroes.size() ) ) + 3 * heroesToMoveTotalCount )
                                                  / ( 4 * heroesToMoveTotalCount )
                                              + startProgressValue );
-        status.drawAITurnProgress( currentProgressValue );
+        drawTurnProgress( currentProgressValue );
 
         if ( bestTargetIndex == -1 ) {
             // Possibly heroes have nothing to do because one of them is blocking the way. Move a random hero randomly and see what happens.
@@ -2944,10 +3043,10 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
                                          ( turnProgressScale * ( heroesToMoveTotalCount - static_cast<uint32_t>( availableHeroes.size() ) ) + heroesToMoveTotalCount )
                                                  / ( 4 * heroesToMoveTotalCount )
                                              + startProgressValue );
-        status.drawAITurnProgress( currentProgressValue );
+        drawTurnProgress( currentProgressValue );
     }
 
-    status.drawAITurnProgress( endProgressValue );
+    drawTurnProgress( endProgressValue );
 
     moreTasksAvailable = availableHeroes.empty();
     return fheroes2::GameMode::END_TURN;
@@ -22,6 +22,8 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <set>
@@ -42,13 +44,12 @@
 #include "color.h"
 #include "difficulty.h"
 #include "game.h"
-#include "game_interface.h"
 #include "game_mode.h"
 #include "game_over.h"
+#include "game_turn_profiler.h"
 #include "ground.h"
 #include "heroes.h"
 #include "heroes_recruits.h"
-#include "interface_status.h"
 #include "kingdom.h"
 #include "logging.h"
 #include "maps.h"
@@ -605,7 +606,7 @@ void AI::Planner::updatePriorityAttackTarget( const Kingdom & kingdom, const Map
 
     const auto enemyArmy = getEnemyArmyOnTile( kingdom.GetColor(), tile );
     if ( !enemyArmy ) {
-        _enemyArmies.erase( tileIndex );
+        removeEnemyArmy( tileIndex );
 
         return;
     }
@@ -616,11 +617,67 @@ void AI::Planner::updatePriorityAttackTarget( const Kingdom & kingdom, const Map
         iter->second = *enemyArmy;
     }
 
+    // The enemy army has changed, its distances should be re-calculated when needed
+    _enemyArmyDistances.erase( tileIndex );
+
     updatePriorityForEnemyArmy( kingdom, *enemyArmy );
 }
 
+void AI::Planner::removeEnemyArmy( const int32_t tileIndex )
+{
+    _enemyArmies.erase( tileIndex );
+    _enemyArmyDistances.erase( tileIndex );
+}
+
+const std::vector<uint32_t> & AI::Planner::getEnemyArmyDistances( const EnemyArmy & enemyArmy )
+{
+    assert( enemyArmy.hero != nullptr && enemyArmy.hero->GetIndex() == enemyArmy.index );
+
+    // This method can be called from several threads at the same time when targets for heroes are evaluated in parallel. The mutex is not held
+    // while distances are being calculated, so that other threads are not blocked by a full map sweep of the pathfinder.
+    std::unique_ptr<AIWorldPathfinder> pathfinder;
+
+    {
+        const std::scoped_lock<std::mutex> lock( _enemyArmyDistancesMutex );
+
+        if ( const auto iter = _enemyArmyDistances.find( enemyArmy.index ); iter != _enemyArmyDistances.end() ) {
+            return iter->second;
+        }
+
+        if ( _enemyArmyPathfinders.empty() ) {
+            pathfinder = std::make_unique<AIWorldPathfinder>();
+        }
+        else {
+            pathfinder = std::move( _enemyArmyPathfinders.back() );
+            _enemyArmyPathfinders.pop_back();
+        }
+    }
+
+    // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
+    pathfinder->setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
+    pathfinder->setSpellPointsReserveRatio( 0.0 );
+
+    pathfinder->reEvaluateIfNeeded( *enemyArmy.hero );
+
+    std::vector<uint32_t> distances( world.getSize() );
+
+    for ( size_t i = 0; i < distances.size(); ++i ) {
+        distances[i] = pathfinder->getDistance( static_cast<int32_t>( i ) );
+    }
+
+    const std::scoped_lock<std::mutex> lock( _enemyArmyDistancesMutex );
+
+    _enemyArmyPathfinders.emplace_back( std::move( pathfinder ) );
+
+    // Distances for the same enemy hero might have been calculated by another thread in the meantime. In this case, the results are identical,
+    // and the already cached ones are returned. References to the elements of std::unordered_map remain valid after the insertion of new elements.
+    return _enemyArmyDistances.try_emplace( enemyArmy.index, std::move( distances ) ).first->second;
+}
+
 fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
 {
+    const Game::TurnProfiler::PhaseTimer phaseTimer( Game::TurnProfiler::Phase::KINGDOM );
+
 #if defined( WITH_DEBUG )
     class AIAutoControlModeCommitter
     {
@@ -653,6 +710,7 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
     _mapActionObjects.clear();
     _priorityTargets.clear();
     _enemyArmies.clear();
+    _enemyArmyDistances.clear();
 
     // Clear the tile army strength cache because the strength of the respective armies might have changed since last time
     _tileArmyStrengthValues.clear();
@@ -668,14 +726,20 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
     }
 
     // Reset the turn progress indicator
-    Interface::StatusPanel & status = Interface::AdventureMap::Get().getStatusPanel();
-    status.drawAITurnProgress( 0 );
+    drawTurnProgress( 0 );
 
-    AudioManager::PlayMusicAsync( MUS::COMPUTER_TURN, Music::PlaybackMode::RESUME_AND_PLAY_INFINITE );
+    if ( !Game::isHeadlessMode() ) {
+        AudioManager::PlayMusicAsync( MUS::COMPUTER_TURN, Music::PlaybackMode::RESUME_AND_PLAY_INFINITE );
+    }
 
     VecHeroes & heroes = kingdom.GetHeroes();
     const VecCastles & castles = kingdom.GetCastles();
 
+#ifdef WITH_DEBUG
+    const uint64_t strengthCacheHitCountAtStart = Army::getStrengthCacheHitCount();
+    const uint64_t strengthCalculationCountAtStart = Army::getStrengthCalculationCount();
+#endif
+
     DEBUG_LOG( DBG_AI, DBG_INFO, Color::String( myColor ) << " starts the turn: " << castles.size() << " castles, " << heroes.size() << " heroes" )
     DEBUG_LOG( DBG_AI, DBG_INFO, "Funds: " << kingdom.GetFunds().String() )
 
@@ -787,7 +851,7 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
     updateKingdomBudget( kingdom );
 
     uint32_t currentProgressValue = 1;
-    status.drawAITurnProgress( currentProgressValue );
+    drawTurnProgress( currentProgressValue );
 
     // If there is a hero who is ready to dig up the Ultimate Artifact, then it is necessary to do this at the beginning of the turn
     if ( const auto iter = std::find_if( heroes.begin(), heroes.end(),
@@ -851,7 +915,11 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
             = ( currentProgressValue == 1 ) ? std::min( static_cast<uint32_t>( heroes.size() ) * 2U + 1U, 8U ) : std::min( currentProgressValue + 2U, 9U );
 
         bool moreTaskForHeroes = false;
-        const fheroes2::GameMode gameState = HeroesTurn( heroes, currentProgressValue, endProgressValue, moreTaskForHeroes );
+        const fheroes2::GameMode gameState = [this, &heroes, &currentProgressValue, endProgressValue, &moreTaskForHeroes]() {
+            const Game::TurnProfiler::PhaseTimer heroesPhaseTimer( Game::TurnProfiler::Phase::HEROES );
+
+            return HeroesTurn( heroes, currentProgressValue, endProgressValue, moreTaskForHeroes );
+        }();
         if ( gameState != fheroes2::GameMode::END_TURN ) {
             return gameState;
         }
@@ -889,7 +957,7 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
         break;
     }
 
-    status.drawAITurnProgress( 9 );
+    drawTurnProgress( 9 );
 
     // Sync the list of castles (if new ones were captured during the turn)
     if ( castles.size() != sortedCastleList.size() ) {
@@ -920,7 +988,11 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
         transferSlowestTroopsToGarrison( hero, castle );
     }
 
-    status.resetAITurnProgress();
+    resetTurnProgress();
+
+    DEBUG_LOG( DBG_AI, DBG_INFO,
+               Color::String( myColor ) << " ends the turn, army strength was taken from the cache " << Army::getStrengthCacheHitCount() - strengthCacheHitCountAtStart
+                                        << " times and calculated " << Army::getStrengthCalculationCount() - strengthCalculationCountAtStart << " times" )
 
     return fheroes2::GameMode::END_TURN;
 }
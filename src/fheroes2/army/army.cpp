@@ -24,9 +24,12 @@
 #include "army.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <set>
@@ -69,6 +72,13 @@ namespace fheroes2
 
 namespace
 {
+    // Generation of the active strength caching scope, 0 if there is no active scope.
+    std::atomic<uint32_t> activeStrengthCacheGeneration{ 0 };
+    uint32_t lastStrengthCacheGeneration{ 0 };
+
+    std::atomic<uint64_t> strengthCacheHitCount{ 0 };
+    std::atomic<uint64_t> strengthCalculationCount{ 0 };
+
     enum class ArmySize : uint32_t
     {
         ARMY_FEW = 1,
@@ -1272,7 +1282,88 @@ int Army::GetMoraleModificator( std::string * strs ) const
     return result;
 }
 
+Army::StrengthCachingScope::StrengthCachingScope()
+{
+    // Nested scopes are not supported.
+    assert( activeStrengthCacheGeneration == 0 );
+
+    ++lastStrengthCacheGeneration;
+    if ( lastStrengthCacheGeneration == 0 ) {
+        ++lastStrengthCacheGeneration;
+    }
+
+    activeStrengthCacheGeneration = lastStrengthCacheGeneration;
+}
+
+Army::StrengthCachingScope::~StrengthCachingScope()
+{
+    activeStrengthCacheGeneration = 0;
+}
+
+uint64_t Army::getStrengthCacheHitCount()
+{
+    return strengthCacheHitCount;
+}
+
+uint64_t Army::getStrengthCalculationCount()
+{
+    return strengthCalculationCount;
+}
+
 double Army::GetStrength() const
+{
+    const uint32_t generation = activeStrengthCacheGeneration.load( std::memory_order_acquire );
+    if ( generation == 0 ) {
+        strengthCalculationCount.fetch_add( 1, std::memory_order_relaxed );
+
+        return calculateStrength();
+    }
+
+    {
+        const std::scoped_lock<std::mutex> lock( _strengthCacheMutex );
+
+        if ( isStrengthCached( generation ) ) {
+            strengthCacheHitCount.fetch_add( 1, std::memory_order_relaxed );
+
+            return _strengthCache.strength;
+        }
+    }
+
+    strengthCalculationCount.fetch_add( 1, std::memory_order_relaxed );
+
+    // The game state cannot be changed within the scope, so all threads calculate the same value for the same troops.
+    const double strength = calculateStrength();
+
+    const std::scoped_lock<std::mutex> lock( _strengthCacheMutex );
+
+    _strengthCache.generation = generation;
+    _strengthCache.commander = commander;
+    _strengthCache.strength = strength;
+
+    _strengthCache.troops.clear();
+    for ( const Troop * troop : *this ) {
+        assert( troop != nullptr );
+
+        _strengthCache.troops.emplace_back( troop->GetID(), troop->GetCount() );
+    }
+
+    return strength;
+}
+
+bool Army::isStrengthCached( const uint32_t generation ) const
+{
+    if ( _strengthCache.generation != generation || _strengthCache.commander != commander || _strengthCache.troops.size() != size() ) {
+        return false;
+    }
+
+    return std::equal( begin(), end(), _strengthCache.troops.begin(), []( const Troop * troop, const std::pair<int, uint32_t> & cachedTroop ) {
+        assert( troop != nullptr );
+
+        return troop->GetID() == cachedTroop.first && troop->GetCount() == cachedTroop.second;
+    } );
+}
+
+double Army::calculateStrength() const
 {
     double result = 0;
 
@@ -26,7 +26,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "monster.h"
@@ -161,6 +163,24 @@ class Army final : public Troops, public Control
 public:
     static const size_t maximumTroopCount = 5;
 
+    // Army strength is cached while an instance of this class exists. It must be created only when the game state cannot be changed,
+    // for example while the AI is evaluating its targets. Even then a cached strength value is used only if the troops of the army
+    // and its commander are the same as when the value was calculated, so temporary armies can still be modified.
+    class StrengthCachingScope
+    {
+    public:
+        StrengthCachingScope();
+        StrengthCachingScope( const StrengthCachingScope & ) = delete;
+
+        ~StrengthCachingScope();
+
+        StrengthCachingScope & operator=( const StrengthCachingScope & ) = delete;
+    };
+
+    // Returns the number of GetStrength() calls which used a cached value and the number of calls which calculated the strength.
+    static uint64_t getStrengthCacheHitCount();
+    static uint64_t getStrengthCalculationCount();
+
     static std::string SizeString( uint32_t );
     static std::string TroopSizeString( const Troop & );
 
@@ -268,7 +288,27 @@ private:
     // the tile index) with a random chance to get an upgraded stack of monsters in the center (if allowed)
     void ArrangeForBattle( const Monster & monster, const uint32_t monstersCount, const int32_t tileIndex, const bool allowUpgrade );
 
+    double calculateStrength() const;
+
+    // Returns true if the strength was cached within the strength caching scope with the given generation for the current troops
+    // and commander of the army. The strength cache mutex must be locked.
+    bool isStrengthCached( const uint32_t generation ) const;
+
     HeroBase * commander;
     bool _isSpreadCombatFormation;
     int color;
+
+    struct StrengthCache
+    {
+        uint32_t generation{ 0 };
+        const HeroBase * commander{ nullptr };
+        // Monster IDs and counts of the troops.
+        std::vector<std::pair<int, uint32_t>> troops;
+        double strength{ 0 };
+    };
+
+    // Army strength cached within the strength caching scope along with the troops and the commander for which it was calculated.
+    // Several threads can read the strength of the same army at the same time so the cache is protected by a mutex.
+    mutable std::mutex _strengthCacheMutex;
+    mutable StrengthCache _strengthCache;
 };
@@ -189,12 +189,12 @@ namespace
         int channelId{ -1 };
     };
 
-    std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+    fheroes2::AGGFileData getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
 
     void LoadWAV( int m82, std::vector<uint8_t> & v )
     {
         DEBUG_LOG( DBG_GAME, DBG_TRACE, M82::GetString( m82 ) )
-        const std::vector<uint8_t> & body = getDataFromAggFile( M82::GetString( m82 ), false );
+        const fheroes2::AGGFileData body = getDataFromAggFile( M82::GetString( m82 ), false );
 
         if ( !body.empty() ) {
             RWStreamBuf wavHeader( 44 );
@@ -214,17 +214,17 @@ namespace
 
             v.reserve( body.size() + 44 );
             v.assign( wavHeader.data(), wavHeader.data() + 44 );
-            v.insert( v.begin() + 44, body.begin(), body.end() );
+            v.insert( v.begin() + 44, body.data(), body.data() + body.size() );
         }
     }
 
     void LoadMID( int xmi, std::vector<uint8_t> & v )
     {
         DEBUG_LOG( DBG_GAME, DBG_TRACE, XMI::GetString( xmi ) )
-        const std::vector<uint8_t> & body = getDataFromAggFile( XMI::GetString( xmi ), xmi >= XMI::MIDI_ORIGINAL_KNIGHT );
+        const fheroes2::AGGFileData body = getDataFromAggFile( XMI::GetString( xmi ), xmi >= XMI::MIDI_ORIGINAL_KNIGHT );
 
         if ( !body.empty() ) {
-            v = Music::Xmi2Mid( body );
+            v = Music::Xmi2Mid( body.data(), body.size() );
         }
     }
 
@@ -492,17 +492,15 @@ namespace
     fheroes2::AGGFile g_midiHeroes2AGG;
     fheroes2::AGGFile g_midiHeroes2xAGG;
 
-    std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion )
+    fheroes2::AGGFileData getDataFromAggFile( const std::string & key, const bool ignoreExpansion )
     {
         if ( !ignoreExpansion && g_midiHeroes2xAGG.isGood() ) {
-            // Make sure that the below container is not const and not a reference
-            // so returning it from the function will invoke a move constructor instead of copy constructor.
-            std::vector<uint8_t> buf = g_midiHeroes2xAGG.read( key );
-            if ( !buf.empty() )
-                return buf;
+            fheroes2::AGGFileData data = g_midiHeroes2xAGG.readData( key );
+            if ( !data.empty() )
+                return data;
         }
 
-        return g_midiHeroes2AGG.read( key );
+        return g_midiHeroes2AGG.readData( key );
     }
 
     AsyncSoundManager g_asyncSoundManager;
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -34,7 +35,9 @@
 #include <random>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "agg_image.h"
 #include "ai_battle.h"
 #include "army.h"
 #include "army_troop.h"
@@ -364,6 +367,16 @@ Battle::Arena::Arena( Army & army1, Army & army2, const int32_t tileIndex, const
     }
 
     if ( isShowInterface ) {
+        // Troop images are decoded in the background while the battle interface is being prepared.
+        std::vector<int> troopIcnIds;
+        for ( const Force * force : { _army1.get(), _army2.get() } ) {
+            for ( const Unit * unit : *force ) {
+                troopIcnIds.push_back( unit->GetMonsterSprite() );
+            }
+        }
+
+        fheroes2::AGG::prefetchICNs( troopIcnIds );
+
         _interface = std::make_unique<Interface>( *this, tileIndex );
         board.SetArea( _interface->GetArea() );
 
@@ -1881,12 +1881,19 @@ void Battle::Interface::RedrawTroopSprite( const Unit & unit )
 
     if ( unit.Modes( SP_STONE | CAP_MIRRORIMAGE ) ) {
         // Apply Stone or Mirror image visual effect.
-        fheroes2::Sprite modifiedMonsterSprite( monsterSprite );
-        const PAL::PaletteType paletteType = unit.Modes( SP_STONE ) ? PAL::PaletteType::GRAY : PAL::PaletteType::MIRROR_IMAGE;
+        const bool isStone = unit.Modes( SP_STONE );
 
-        fheroes2::ApplyPalette( modifiedMonsterSprite, PAL::GetPalette( paletteType ) );
+        if ( isCurrentMonsterAction ) {
+            // The sprite of the current action is not an ICN frame so it is not cached.
+            fheroes2::Sprite modifiedMonsterSprite( monsterSprite );
+            fheroes2::ApplyPalette( modifiedMonsterSprite, PAL::GetPalette( isStone ? PAL::PaletteType::GRAY : PAL::PaletteType::MIRROR_IMAGE ) );
 
-        drawnPosition = _drawTroopSprite( unit, modifiedMonsterSprite );
+            drawnPosition = _drawTroopSprite( unit, modifiedMonsterSprite );
+        }
+        else {
+            const TroopSpriteCache::Effect effect = isStone ? TroopSpriteCache::Effect::STONE : TroopSpriteCache::Effect::MIRROR_IMAGE;
+            drawnPosition = _drawTroopSprite( unit, _troopSpriteCache.get( unit.GetMonsterSprite(), unit.GetFrame(), effect, 0 ) );
+        }
     }
     else {
         drawnPosition = _drawTroopSprite( unit, monsterSprite );
@@ -1894,7 +1901,8 @@ void Battle::Interface::RedrawTroopSprite( const Unit & unit )
 
     if ( _currentUnit == &unit && _spriteInsteadCurrentUnit == nullptr ) {
         // Current unit's turn which is idling. Highlight this unit's contour.
-        const fheroes2::Sprite & monsterContour = fheroes2::CreateContour( monsterSprite, _contourColor );
+        const fheroes2::Sprite & monsterContour
+            = _troopSpriteCache.get( unit.GetMonsterSprite(), unit.GetFrame(), TroopSpriteCache::Effect::CONTOUR, _contourColor );
         fheroes2::Blit( monsterContour, _mainSurface, drawnPosition.x, drawnPosition.y, unit.isReflect() );
     }
 }
@@ -6764,6 +6772,77 @@ void Battle::Interface::ProcessingHeroDialogResult( const int result, Actions &
     }
 }
 
+Battle::TroopSpriteCache::TroopSpriteCache()
+{
+    _entries.reserve( maxEntries );
+}
+
+Battle::TroopSpriteCache::~TroopSpriteCache()
+{
+    clear();
+}
+
+const fheroes2::Sprite & Battle::TroopSpriteCache::get( const int icnId, const uint32_t frameId, const Effect effect, const uint8_t contourColor )
+{
+    ++_usageCounter;
+
+    Entry * leastRecentlyUsed = nullptr;
+
+    for ( Entry & entry : _entries ) {
+        if ( entry.icnId == icnId && entry.frameId == frameId && entry.effect == effect && entry.contourColor == contourColor ) {
+            ++_hitCount;
+            entry.lastUsage = _usageCounter;
+            return entry.sprite;
+        }
+
+        if ( leastRecentlyUsed == nullptr || entry.lastUsage < leastRecentlyUsed->lastUsage ) {
+            leastRecentlyUsed = &entry;
+        }
+    }
+
+    ++_missCount;
+
+    // The memory for all entries is reserved in advance so the existing entries are never moved.
+    Entry & entry = ( _entries.size() < maxEntries ) ? _entries.emplace_back() : *leastRecentlyUsed;
+    entry.icnId = icnId;
+    entry.frameId = frameId;
+    entry.effect = effect;
+    entry.contourColor = contourColor;
+    entry.lastUsage = _usageCounter;
+
+    const fheroes2::Sprite & original = fheroes2::AGG::GetICN( icnId, frameId );
+
+    switch ( effect ) {
+    case Effect::STONE:
+    case Effect::MIRROR_IMAGE:
+        // The image buffer of the evicted entry is reused if the sprite has the same size.
+        entry.sprite = original;
+        fheroes2::ApplyPalette( entry.sprite, PAL::GetPalette( effect == Effect::STONE ? PAL::PaletteType::GRAY : PAL::PaletteType::MIRROR_IMAGE ) );
+        break;
+    case Effect::CONTOUR:
+        entry.sprite = fheroes2::CreateContour( original, contourColor );
+        break;
+    default:
+        // Did you add a new effect? Add the logic above!
+        assert( 0 );
+        break;
+    }
+
+    return entry.sprite;
+}
+
+void Battle::TroopSpriteCache::clear()
+{
+    if ( _hitCount > 0 || _missCount > 0 ) {
+        DEBUG_LOG( DBG_BATTLE, DBG_TRACE, "Troop sprite cache: " << _hitCount << " hits, " << _missCount << " misses, " << _entries.size() << " entries" )
+    }
+
+    _entries.clear();
+    _usageCounter = 0;
+    _hitCount = 0;
+    _missCount = 0;
+}
+
 bool Battle::PopupDamageInfo::_setDamageInfoBase( const Unit * defender )
 {
     if ( defender == nullptr || ( defender == _defender ) ) {
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -290,6 +291,50 @@ namespace Battle
         bool _needDelay{ true };
     };
 
+    // Keeps the recently used troop sprites with applied visual effects to avoid creating them again for every rendered frame.
+    class TroopSpriteCache
+    {
+    public:
+        enum class Effect : uint8_t
+        {
+            STONE,
+            MIRROR_IMAGE,
+            CONTOUR
+        };
+
+        TroopSpriteCache();
+        TroopSpriteCache( const TroopSpriteCache & ) = delete;
+
+        ~TroopSpriteCache();
+
+        TroopSpriteCache & operator=( const TroopSpriteCache & ) = delete;
+
+        // The contour color is used only for the contour effect.
+        const fheroes2::Sprite & get( const int icnId, const uint32_t frameId, const Effect effect, const uint8_t contourColor );
+
+        void clear();
+
+    private:
+        struct Entry
+        {
+            int icnId{ ICN::UNKNOWN };
+            uint32_t frameId{ 0 };
+            Effect effect{ Effect::STONE };
+            uint8_t contourColor{ 0 };
+            uint32_t lastUsage{ 0 };
+            fheroes2::Sprite sprite;
+        };
+
+        // Stone and Mirror Image effects are applied to all animation frames of a few units while the contour
+        // of the current unit changes its color while the unit is idling.
+        static constexpr size_t maxEntries = 64;
+
+        std::vector<Entry> _entries;
+        uint32_t _usageCounter{ 0 };
+        uint32_t _hitCount{ 0 };
+        uint32_t _missCount{ 0 };
+    };
+
     class Interface
     {
     public:
@@ -482,6 +527,7 @@ namespace Battle
         const Unit * _movingUnit{ nullptr };
         const Unit * _flyingUnit{ nullptr };
         const fheroes2::Sprite * _spriteInsteadCurrentUnit{ nullptr };
+        TroopSpriteCache _troopSpriteCache;
         fheroes2::Point _movingPos;
         fheroes2::Point _flyingPos;
 
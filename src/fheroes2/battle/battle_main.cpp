@@ -42,6 +42,7 @@
 #include "captain.h"
 #include "dialog.h"
 #include "game.h"
+#include "game_turn_profiler.h"
 #include "heroes.h"
 #include "heroes_base.h"
 #include "kingdom.h"
@@ -286,6 +287,8 @@ namespace
 
 Battle::Result Battle::Loader( Army & army1, Army & army2, int32_t mapsindex )
 {
+    const Game::TurnProfiler::PhaseTimer phaseTimer( Game::TurnProfiler::Phase::BATTLE );
+
     Result result;
 
     // Validate the arguments - check if battle should even load
@@ -38,6 +38,44 @@
 namespace
 {
     const uint32_t MOAT_PENALTY = UINT16_MAX;
+
+    // Returns the index of the given node in the node cache or -1 if this node is not a valid unit position
+    int32_t getNodeCacheIndex( const Battle::BattleNodeIndex & nodeIdx )
+    {
+        const auto [headCellIdx, tailCellIdx] = nodeIdx;
+
+        if ( !Battle::Board::isValidIndex( headCellIdx ) ) {
+            return -1;
+        }
+
+        if ( tailCellIdx == -1 ) {
+            return headCellIdx * 3;
+        }
+
+        if ( tailCellIdx == headCellIdx - 1 ) {
+            return headCellIdx * 3 + 1;
+        }
+
+        if ( tailCellIdx == headCellIdx + 1 ) {
+            return headCellIdx * 3 + 2;
+        }
+
+        return -1;
+    }
+
+    Battle::BattleNodeIndex getNodeIndex( const int32_t nodeCacheIdx )
+    {
+        const int32_t headCellIdx = nodeCacheIdx / 3;
+
+        switch ( nodeCacheIdx % 3 ) {
+        case 0:
+            return { headCellIdx, -1 };
+        case 1:
+            return { headCellIdx, headCellIdx - 1 };
+        default:
+            return { headCellIdx, headCellIdx + 1 };
+        }
+    }
 }
 
 namespace Battle
@@ -73,8 +111,9 @@ namespace Battle
         const Castle * castle = Arena::GetCastle();
         const bool isMoatBuilt = castle && castle->isBuild( BUILD_MOAT );
 
-        _cache.clear();
-        _cache.try_emplace( _pathStart );
+        _cache.fill( {} );
+
+        assert( getNodeCacheIndex( _pathStart ) != -1 );
 
         // Flying units can land wherever they can fit
         if ( _isFlying ) {
@@ -87,15 +126,20 @@ namespace Battle
 
                 assert( pos.isValidForUnit( unit ) );
 
-                const int32_t headCellIdx = pos.GetHead()->GetIndex();
-                const int32_t tailCellIdx = pos.GetTail() ? pos.GetTail()->GetIndex() : -1;
+                const BattleNodeIndex nodeIdx = { pos.GetHead()->GetIndex(), pos.GetTail() ? pos.GetTail()->GetIndex() : -1 };
+                if ( nodeIdx == _pathStart ) {
+                    continue;
+                }
+
+                const int32_t nodeCacheIdx = getNodeCacheIndex( nodeIdx );
+                assert( nodeCacheIdx != -1 );
 
-                if ( const auto [iter, inserted] = _cache.try_emplace( { headCellIdx, tailCellIdx } ); inserted ) {
+                if ( BattleNode & node = _cache[nodeCacheIdx]; node._from == BattleNodeIndex{ -1, -1 } ) {
                     // Wide units can occupy overlapping positions, the distance between which is actually zero,
                     // but since the movement takes place, we will consider the distance equal to 1 in this case
                     const uint32_t distance = std::max( Board::GetDistance( unit.GetPosition(), pos ), 1U );
 
-                    iter->second.update( _pathStart, 1, distance );
+                    node.update( _pathStart, 1, distance );
                 }
             }
 
@@ -132,7 +176,7 @@ namespace Battle
 
         for ( size_t nodesToExploreIdx = 0; nodesToExploreIdx < nodesToExplore.size(); ++nodesToExploreIdx ) {
             const BattleNodeIndex currentNodeIdx = nodesToExplore[nodesToExploreIdx];
-            const BattleNode & currentNode = _cache[currentNodeIdx];
+            const BattleNode & currentNode = _cache[getNodeCacheIndex( currentNodeIdx )];
 
             if ( _isWide ) {
                 assert( currentNodeIdx.first != -1 && currentNodeIdx.second != -1 );
@@ -169,7 +213,10 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : movementPenalty );
                     const uint32_t distance = currentNode._distance + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : 1 );
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    const int32_t newNodeCacheIdx = getNodeCacheIndex( newNodeIdx );
+                    assert( newNodeCacheIdx != -1 );
+
+                    BattleNode & newNode = _cache[newNodeCacheIdx];
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -206,7 +253,10 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + movementPenalty;
                     const uint32_t distance = currentNode._distance + 1;
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    const int32_t newNodeCacheIdx = getNodeCacheIndex( newNodeIdx );
+                    assert( newNodeCacheIdx != -1 );
+
+                    BattleNode & newNode = _cache[newNodeCacheIdx];
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -217,6 +267,21 @@ namespace Battle
         }
     }
 
+    const BattleNode * BattlePathfinder::getReachableNode( const BattleNodeIndex & nodeIdx ) const
+    {
+        const int32_t nodeCacheIdx = getNodeCacheIndex( nodeIdx );
+        if ( nodeCacheIdx == -1 ) {
+            return nullptr;
+        }
+
+        const BattleNode & node = _cache[nodeCacheIdx];
+        if ( nodeIdx != _pathStart && node._from == BattleNodeIndex{ -1, -1 } ) {
+            return nullptr;
+        }
+
+        return &node;
+    }
+
     bool BattlePathfinder::isPositionReachable( const Unit & unit, const Position & position, const bool isOnCurrentTurn )
     {
         // Invalid positions are allowed here, but they are always unreachable
@@ -228,14 +293,12 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        if ( iter == _cache.end() ) {
+        const BattleNode * node = getReachableNode( nodeIdx );
+        if ( node == nullptr ) {
             return false;
         }
 
-        const auto & [index, node] = *iter;
-
-        return ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= _speed );
+        return !isOnCurrentTurn || node->_cost <= _speed;
     }
 
     uint32_t BattlePathfinder::getCost( const Unit & unit, const Position & position )
@@ -246,14 +309,10 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
-
-        const auto & [index, node] = *iter;
-        // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        const BattleNode * node = getReachableNode( nodeIdx );
+        assert( node != nullptr );
 
-        return node._cost;
+        return node->_cost;
     }
 
     uint32_t BattlePathfinder::getDistance( const Unit & unit, const Position & position )
@@ -264,14 +323,10 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        const BattleNode * node = getReachableNode( nodeIdx );
+        assert( node != nullptr );
 
-        const auto & [index, node] = *iter;
-        // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
-
-        return node._distance;
+        return node->_distance;
     }
 
     Indexes BattlePathfinder::getAllAvailableMoves( const Unit & unit )
@@ -280,12 +335,16 @@ namespace Battle
 
         std::set<int32_t> boardIndexes;
 
-        for ( const auto & [index, node] : _cache ) {
-            if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
+        for ( int32_t nodeCacheIdx = 0; nodeCacheIdx < static_cast<int32_t>( _cache.size() ); ++nodeCacheIdx ) {
+            const BattleNode & node = _cache[nodeCacheIdx];
+            if ( node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
                 continue;
             }
 
-            assert( index.first != -1 );
+            const BattleNodeIndex index = getNodeIndex( nodeCacheIdx );
+            if ( index == _pathStart ) {
+                continue;
+            }
 
             boardIndexes.insert( index.first );
         }
@@ -310,21 +369,18 @@ namespace Battle
         BattleNodeIndex lastReachableNodeIdx{ -1, -1 };
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = getReachableNode( nodeIdx ); node != nullptr; node = getReachableNode( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
-            // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
-
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -365,21 +421,18 @@ namespace Battle
 
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = getReachableNode( nodeIdx ); node != nullptr; node = getReachableNode( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
-            // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
-
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -21,9 +21,7 @@
 #pragma once
 
 #include <array>
-#include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
 
 #include "battle_board.h"
@@ -35,19 +33,6 @@ namespace Battle
 
     using BattleNodeIndex = std::pair<int32_t, int32_t>;
 
-    struct BattleNodeIndexHash final
-    {
-        std::size_t operator()( const BattleNodeIndex & index ) const noexcept
-        {
-            const uint64_t f = index.first;
-            const uint64_t s = index.second;
-
-            std::hash<uint64_t> hasher;
-
-            return hasher( ( f << 32 ) + s );
-        }
-    };
-
     struct BattleNode final
     {
         BattleNodeIndex _from{ -1, -1 };
@@ -108,7 +93,13 @@ namespace Battle
         // Rebuilds the graph of available positions for the given unit if necessary (if it is not already cached)
         void reEvaluateIfNeeded( const Unit & unit );
 
-        std::unordered_map<BattleNodeIndex, BattleNode, BattleNodeIndexHash> _cache;
+        // Returns the node with the given index if this node is reachable in principle (or it is the start of the path), otherwise returns nullptr
+        const BattleNode * getReachableNode( const BattleNodeIndex & nodeIdx ) const;
+
+        // Each board cell can be occupied by the head of a unit in three ways: by a unit that occupies only one cell, or by a wide unit
+        // whose tail is to the left or to the right of its head. Nodes are stored in a flat array indexed by the head cell and the tail
+        // position, a node which has not been reached has no source node.
+        std::array<BattleNode, Board::sizeInCells * 3> _cache;
 
         // Parameters of the unit for which the current cache is created
         BattleNodeIndex _pathStart{ -1, -1 };
@@ -806,7 +806,7 @@ namespace Campaign
     std::string CampaignAwardData::getName() const
     {
         if ( !_customName.empty() )
-            return _( _customName );
+            return Translation::gettext( _customName );
 
         switch ( _type ) {
         case CampaignAwardData::TYPE_CREATURE_CURSE:
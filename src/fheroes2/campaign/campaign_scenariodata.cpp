@@ -806,12 +806,12 @@ namespace Campaign
 
     const char * ScenarioData::getScenarioName() const
     {
-        return _( _scenarioName );
+        return Translation::gettext( _scenarioName );
     }
 
     const char * ScenarioData::getDescription() const
     {
-        return _( _description );
+        return Translation::gettext( _description );
     }
 
     bool Campaign::ScenarioData::isMapFilePresent() const
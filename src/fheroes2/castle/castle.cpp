@@ -2177,7 +2177,7 @@ void Castle::setName( const std::set<std::string, std::less<>> & usedNames )
     Rand::Shuffle( shuffledCastleNames );
 
     for ( const char * originalName : shuffledCastleNames ) {
-        const char * translatedCastleName = _( originalName );
+        const char * translatedCastleName = Translation::gettext( originalName );
         if ( usedNames.count( translatedCastleName ) < 1 ) {
             _name = translatedCastleName;
             return;
@@ -506,6 +506,9 @@ namespace CastleDialog
 
     void redrawAllBuildings( const Castle & castle, const fheroes2::Point & offset, const BuildingsRenderQueue & buildings,
                              const CastleDialog::FadeBuilding & alphaBuilding, const uint32_t animationIndex );
+
+    // Starts decoding of the town background and building images in the background.
+    void prefetchBuildingImages( const int race );
 }
 
 struct VecCastles : public std::vector<Castle *>
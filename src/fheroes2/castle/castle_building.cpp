@@ -463,6 +463,17 @@ CastleDialog::BuildingsRenderQueue::BuildingsRenderQueue( const Castle & castle,
     }
 }
 
+void CastleDialog::prefetchBuildingImages( const int race )
+{
+    std::vector<int> icnIds{ getTownIcnId( race ) };
+
+    for ( const BuildingType buildingId : fheroes2::getBuildingDrawingPriorities( race, Settings::Get().getCurrentMapInfo().version ) ) {
+        icnIds.push_back( Castle::GetICNBuilding( buildingId, race ) );
+    }
+
+    fheroes2::AGG::prefetchICNs( icnIds );
+}
+
 bool CastleDialog::FadeBuilding::updateFadeAlpha()
 {
     if ( _alpha < 255 && Game::validateAnimationDelay( Game::CASTLE_BUILD_DELAY ) ) {
@@ -222,6 +222,9 @@ Castle::CastleDialogReturnValue Castle::OpenDialog( const bool openConstructionW
     // or from the Game Area that will set the appropriate cursor after this dialog is closed.
     Cursor::Get().SetThemes( Cursor::POINTER );
 
+    // Town images are decoded in the background while the game screen is fading out.
+    CastleDialog::prefetchBuildingImages( _race );
+
     fheroes2::Display & display = fheroes2::Display::instance();
 
     fheroes2::Rect dialogRoi;
@@ -35,5 +35,5 @@ void Dialog::ArtifactSetAssembled( const ArtifactSetData & artifactSetData )
 
     AudioManager::PlaySound( M82::TREASURE );
 
-    fheroes2::showStandardTextMessage( artifact.GetName(), _( artifactSetData._assembleMessage ), Dialog::OK, { &artifactUI } );
+    fheroes2::showStandardTextMessage( artifact.GetName(), Translation::gettext( artifactSetData._assembleMessage ), Dialog::OK, { &artifactUI } );
 }
@@ -138,7 +138,7 @@ namespace
 
             offsetY += 2;
 
-            fheroes2::Text name( _( Game::getHotKeyEventNameByEventId( hotKeyEvent.first ) ), fontType );
+            fheroes2::Text name( Translation::gettext( Game::getHotKeyEventNameByEventId( hotKeyEvent.first ) ), fontType );
             name.fitToOneRow( keyDescriptionLength );
             name.draw( offsetX + 4, offsetY, display );
 
@@ -172,10 +172,10 @@ namespace
             fheroes2::MultiFontText title;
 
             title.add( fheroes2::Text{ _( "Category: " ), fheroes2::FontType::normalYellow() } );
-            title.add( fheroes2::Text{ _( Game::getHotKeyCategoryName( hotKeyEvent.second ) ), fheroes2::FontType::normalWhite() } );
+            title.add( fheroes2::Text{ Translation::gettext( Game::getHotKeyCategoryName( hotKeyEvent.second ) ), fheroes2::FontType::normalWhite() } );
             title.add( fheroes2::Text{ "\n\n", fheroes2::FontType::normalWhite() } );
             title.add( fheroes2::Text{ _( "Event: " ), fheroes2::FontType::normalYellow() } );
-            title.add( fheroes2::Text{ _( Game::getHotKeyEventNameByEventId( hotKeyEvent.first ) ), fheroes2::FontType::normalWhite() } );
+            title.add( fheroes2::Text{ Translation::gettext( Game::getHotKeyEventNameByEventId( hotKeyEvent.first ) ), fheroes2::FontType::normalWhite() } );
             title.add( fheroes2::Text{ "\n\n", fheroes2::FontType::normalWhite() } );
             title.add( fheroes2::Text{ _( "Hotkey: " ), fheroes2::FontType::normalYellow() } );
             title.add( fheroes2::Text{ Game::getHotKeyNameByEventId( hotKeyEvent.first ), fheroes2::FontType::normalWhite() } );
@@ -202,10 +202,10 @@ namespace
             fheroes2::MultiFontText title;
 
             title.add( fheroes2::Text{ _( "Category: " ), fheroes2::FontType::normalYellow() } );
-            title.add( fheroes2::Text{ _( Game::getHotKeyCategoryName( hotKeyEvent.second ) ), fheroes2::FontType::normalWhite() } );
+            title.add( fheroes2::Text{ Translation::gettext( Game::getHotKeyCategoryName( hotKeyEvent.second ) ), fheroes2::FontType::normalWhite() } );
             title.add( fheroes2::Text{ "\n\n", fheroes2::FontType::normalWhite() } );
             title.add( fheroes2::Text{ _( "Event: " ), fheroes2::FontType::normalYellow() } );
-            title.add( fheroes2::Text{ _( Game::getHotKeyEventNameByEventId( hotKeyEvent.first ) ), fheroes2::FontType::normalWhite() } );
+            title.add( fheroes2::Text{ Translation::gettext( Game::getHotKeyEventNameByEventId( hotKeyEvent.first ) ), fheroes2::FontType::normalWhite() } );
 
             const int returnValue = fheroes2::showMessage( fheroes2::Text{}, title, Dialog::OK | Dialog::CANCEL, { &hotKeyUI } );
 
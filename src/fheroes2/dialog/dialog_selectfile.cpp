@@ -45,6 +45,7 @@
 #include "interface_list.h"
 #include "localevent.h"
 #include "maps_fileinfo.h"
+#include "maps_fileinfo_index.h"
 #include "math_base.h"
 #include "screen.h"
 #include "settings.h"
@@ -233,14 +234,20 @@ namespace
         ListFiles files;
         files.ReadDir( Game::GetSaveDir(), Game::GetSaveFileExtension() );
 
-        MapsFileInfoList mapInfos;
-        mapInfos.reserve( files.size() );
+        // Reading of a save file changes the version of the current save file so save files cannot be read in parallel.
+        const Maps::FileInfoReader reader
+            = []( const std::string & filePath, Maps::IndexedFileInfo & fileInfo ) { return Game::LoadSAV2FileInfo( filePath, fileInfo.info, fileInfo.gameType ); };
+
+        std::vector<Maps::IndexedFileInfo> saveInfos = Maps::getIndexedFileInfos( "saves", files, reader, false );
 
-        for ( std::string & saveFile : files ) {
-            Maps::FileInfo mapInfo;
+        const int gameType = Settings::Get().GameType();
+
+        MapsFileInfoList mapInfos;
+        mapInfos.reserve( saveInfos.size() );
 
-            if ( Game::LoadSAV2FileInfo( std::move( saveFile ), mapInfo ) ) {
-                mapInfos.emplace_back( std::move( mapInfo ) );
+        for ( Maps::IndexedFileInfo & saveInfo : saveInfos ) {
+            if ( gameType & saveInfo.gameType ) {
+                mapInfos.emplace_back( std::move( saveInfo.info ) );
             }
         }
 
@@ -63,6 +63,7 @@
 #include "embedded_image.h"
 #include "exception.h"
 #include "game.h"
+#include "game_io.h"
 #include "game_logo.h"
 #include "game_video.h"
 #include "game_video_type.h"
@@ -261,6 +262,20 @@ namespace
         std::unique_ptr<fheroes2::h2d::H2DInitializer> _h2dInitializer;
     };
 
+    // Autosave files are written by the worker thread which has to complete its work before the application exits.
+    class AutoSaveWriterStopper
+    {
+    public:
+        AutoSaveWriterStopper() = default;
+        AutoSaveWriterStopper( const AutoSaveWriterStopper & ) = delete;
+        AutoSaveWriterStopper & operator=( const AutoSaveWriterStopper & ) = delete;
+
+        ~AutoSaveWriterStopper()
+        {
+            Game::stopAutoSaveWriter();
+        }
+    };
+
     // This function checks for a possible situation when a user uses a demo version
     // of the game. There is no 100% certain way to detect this, so assumptions are made.
     bool isProbablyDemoVersion()
@@ -341,6 +356,8 @@ int main( int argc, char ** argv )
         const AudioManager::AudioInitializer audioInitializer( dataInitializer.getOriginalAGGFilePath(), dataInitializer.getExpansionAGGFilePath(), midiSoundFonts,
                                                                timidityCfgPath );
 
+        const AutoSaveWriterStopper autoSaveWriterStopper;
+
         // Load palette.
         fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ) );
         fheroes2::Display::instance().changePalette( nullptr, true );
@@ -65,6 +65,7 @@ namespace
 
     bool updateSoundsOnFocusUpdate = true;
     bool needFadeIn{ true };
+    bool headlessMode{ false };
 
     uint32_t maps_animation_frame = 0;
 }
@@ -189,6 +190,16 @@ bool Game::validateDisplayFadeIn()
     return false;
 }
 
+bool Game::isHeadlessMode()
+{
+    return headlessMode;
+}
+
+void Game::setHeadlessMode( const bool enable )
+{
+    headlessMode = enable;
+}
+
 void Game::Init()
 {
     // set global events
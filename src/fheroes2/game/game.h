@@ -93,6 +93,11 @@ namespace Game
     // If display fade-in state is set reset it to false and return true. Otherwise return false.
     bool validateDisplayFadeIn();
 
+    // In the headless mode the game is played only by AI players without video, audio and user input: nothing is rendered,
+    // no sounds are played and no dialogs are shown.
+    bool isHeadlessMode();
+    void setHeadlessMode( const bool enable );
+
     int GetKingdomColors();
     int GetActualKingdomColors();
     void DialogPlayers( int color, std::string title, std::string message );
@@ -348,7 +348,7 @@ namespace
                 os << "# " << getHotKeyCategoryName( currentCategory ) << ':' << std::endl;
             }
 
-            const char * eventName = _( hotKeyEventInfo[eventId].name );
+            const char * eventName = Translation::gettext( hotKeyEventInfo[eventId].name );
             assert( strlen( eventName ) > 0 );
 #if defined( WITH_DEBUG )
             const bool isUnique = duplicationStringVerifier.emplace( eventName ).second;
@@ -435,7 +435,7 @@ void Game::HotKeysLoad( const std::string & filename )
             const fheroes2::LanguageSwitcher languageSwitcher( fheroes2::SupportedLanguage::English );
 
             for ( int eventId = hotKeyEventToInt( HotKeyEvent::NONE ) + 1; eventId < hotKeyEventToInt( HotKeyEvent::NO_EVENT ); ++eventId ) {
-                const char * eventName = _( hotKeyEventInfo[eventId].name );
+                const char * eventName = Translation::gettext( hotKeyEventInfo[eventId].name );
                 std::string value = config.StrParams( eventName );
                 if ( value.empty() ) {
                     // TODO: remove this temporary workaround
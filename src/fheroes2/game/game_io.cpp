@@ -24,9 +24,14 @@
 #include "game_io.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cctype>
+#include <condition_variable>
 #include <cstdint>
 #include <ctime>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <utility>
 
@@ -42,6 +47,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_font.h"
@@ -103,53 +109,247 @@ namespace
     {
         return stream >> hdr.status >> hdr.info >> hdr.gameType;
     }
-}
 
-bool Game::AutoSave()
-{
-    return Game::Save( System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() ), true );
-}
+    // Serializes the current game into the uncompressed header and data of a save file.
+    bool serializeGame( RWStreamBuf & headerStream, RWStreamBuf & dataStream )
+    {
+        const Settings & conf = Settings::Get();
 
-bool Game::Save( const std::string & filePath, const bool autoSave /* = false */ )
-{
-    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+        headerStream.setBigendian( true );
+        dataStream.setBigendian( true );
 
-    const Settings & conf = Settings::Get();
+        // Always use the latest version of the file save format
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+        uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
 
-    StreamFile fileStream;
-    fileStream.setBigendian( true );
+        // Header
+        headerStream << SAV2ID3 << std::to_string( saveFileVersion ) << saveFileVersion
+                     << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
+        if ( headerStream.fail() ) {
+            return false;
+        }
 
-    if ( !fileStream.open( filePath, "wb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
-        return false;
+        dataStream << World::Get() << Settings::Get() << GameOver::Result::Get();
+        if ( dataStream.fail() ) {
+            return false;
+        }
+
+        if ( conf.isCampaignGameType() ) {
+            dataStream << Campaign::CampaignSaveData::Get();
+        }
+
+        // End-of-data marker
+        dataStream << SAV2ID3;
+
+        return !dataStream.fail();
     }
 
-    // Always use the latest version of the file save format
-    SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
-    uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
+    // Compresses the game data and writes the save file. The file is written under a temporary name first and then renamed,
+    // so the previous version of the file stays intact if the writing fails.
+    bool writeSaveFile( const std::string & filePath, const RWStreamBuf & headerStream, const RWStreamBuf & dataStream )
+    {
+        const std::string tempFilePath = filePath + ".tmp";
 
-    // Header
-    fileStream << SAV2ID3 << std::to_string( saveFileVersion ) << saveFileVersion
-               << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
-    if ( fileStream.fail() ) {
-        return false;
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( !fileStream.open( tempFilePath, "wb" ) ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << tempFilePath )
+                return false;
+            }
+
+            fileStream.putRaw( headerStream.data(), headerStream.size() );
+
+            if ( fileStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) || !fileStream.flush() ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Error writing the file " << tempFilePath )
+
+                fileStream.close();
+                System::Unlink( tempFilePath );
+
+                return false;
+            }
+        }
+
+        if ( !System::Rename( tempFilePath, filePath ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Error renaming the file " << tempFilePath << " to " << filePath )
+
+            System::Unlink( tempFilePath );
+
+            return false;
+        }
+
+        return true;
     }
 
-    RWStreamBuf dataStream;
-    dataStream.setBigendian( true );
+    // Writes save files in the background.
+    class SaveFileWriter final : public MultiThreading::AsyncManager
+    {
+    public:
+        void pushTask( std::string filePath, std::unique_ptr<RWStreamBuf> headerStream, std::unique_ptr<RWStreamBuf> dataStream )
+        {
+            assert( headerStream && dataStream );
 
-    dataStream << World::Get() << Settings::Get() << GameOver::Result::Get();
-    if ( dataStream.fail() ) {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            // Only the latest state of the game is worth writing, so a pending save to the same file is dropped.
+            _tasks.erase( std::remove_if( _tasks.begin(), _tasks.end(), [&filePath]( const Task & task ) { return task.filePath == filePath; } ), _tasks.end() );
+
+            _tasks.push_back( { std::move( filePath ), std::move( headerStream ), std::move( dataStream ) } );
+
+            notifyWorker();
+        }
+
+        bool checkFailure()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            return std::exchange( _hasFailed, false );
+        }
+
+        void waitForCompletion()
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _taskCompletion.wait( lock, [this] { return _tasks.empty() && !_currentTask.dataStream; } );
+        }
+
+    private:
+        struct Task
+        {
+            std::string filePath;
+            std::unique_ptr<RWStreamBuf> headerStream;
+            std::unique_ptr<RWStreamBuf> dataStream;
+        };
+
+        std::deque<Task> _tasks;
+        Task _currentTask;
+
+        bool _hasFailed{ false };
+
+        std::condition_variable _taskCompletion;
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            if ( _tasks.empty() ) {
+                return false;
+            }
+
+            _currentTask = std::move( _tasks.front() );
+            _tasks.pop_front();
+
+            return true;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            if ( !_currentTask.dataStream ) {
+                return;
+            }
+
+            const bool isWritten = writeSaveFile( _currentTask.filePath, *_currentTask.headerStream, *_currentTask.dataStream );
+            if ( isWritten ) {
+                DEBUG_LOG( DBG_GAME, DBG_INFO, "The file " << _currentTask.filePath << " has been saved." )
+            }
+            else {
+                ERROR_LOG( "Failed to save the file " << _currentTask.filePath )
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _currentTask = {};
+
+                if ( !isWritten ) {
+                    _hasFailed = true;
+                }
+            }
+
+            _taskCompletion.notify_all();
+        }
+    };
+
+    SaveFileWriter saveFileWriter;
+
+    // Keeps a copy of the current game while a save file is being loaded and restores it on destruction unless the save file
+    // has been loaded successfully. If there is no current game, there is nothing to restore.
+    class CurrentGameRestorer
+    {
+    public:
+        CurrentGameRestorer()
+            : _isRestoreNeeded( world.getSize() > 0 )
+        {
+            if ( !_isRestoreNeeded ) {
+                return;
+            }
+
+            _gameStream.setBigendian( true );
+            _gameStream << World::Get() << Settings::Get() << GameOver::Result::Get() << Campaign::CampaignSaveData::Get();
+
+            _isRestoreNeeded = !_gameStream.fail();
+        }
+
+        CurrentGameRestorer( const CurrentGameRestorer & ) = delete;
+
+        ~CurrentGameRestorer()
+        {
+            if ( !_isRestoreNeeded ) {
+                return;
+            }
+
+            // The copy of the game has been made in the latest format.
+            Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+            _gameStream >> World::Get() >> Settings::Get() >> GameOver::Result::Get() >> Campaign::CampaignSaveData::Get();
+
+            if ( _gameStream.fail() ) {
+                ERROR_LOG( "Failed to restore the current game." )
+            }
+        }
+
+        CurrentGameRestorer & operator=( const CurrentGameRestorer & ) = delete;
+
+        void disable()
+        {
+            _isRestoreNeeded = false;
+        }
+
+    private:
+        RWStreamBuf _gameStream;
+        bool _isRestoreNeeded;
+    };
+}
+
+bool Game::AutoSave()
+{
+    auto headerStream = std::make_unique<RWStreamBuf>();
+    auto dataStream = std::make_unique<RWStreamBuf>();
+
+    if ( !serializeGame( *headerStream, *dataStream ) ) {
         return false;
     }
 
-    if ( conf.isCampaignGameType() ) {
-        dataStream << Campaign::CampaignSaveData::Get();
-    }
+    // Compression and writing of the save file take a noticeable time on large maps so they are done by the worker thread.
+    saveFileWriter.pushTask( System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() ), std::move( headerStream ), std::move( dataStream ) );
 
-    // End-of-data marker
-    dataStream << SAV2ID3;
-    if ( dataStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) ) {
+    return true;
+}
+
+bool Game::Save( const std::string & filePath, const bool autoSave /* = false */ )
+{
+    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+
+    // The worker thread might be writing a file with the same name at the moment, and it uses the same temporary file.
+    saveFileWriter.waitForCompletion();
+
+    RWStreamBuf headerStream;
+    RWStreamBuf dataStream;
+
+    if ( !serializeGame( headerStream, dataStream ) || !writeSaveFile( filePath, headerStream, dataStream ) ) {
         return false;
     }
 
@@ -160,10 +360,24 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
     return true;
 }
 
+bool Game::checkAutoSaveFailure()
+{
+    return saveFileWriter.checkFailure();
+}
+
+void Game::stopAutoSaveWriter()
+{
+    saveFileWriter.waitForCompletion();
+    saveFileWriter.stopWorker();
+}
+
 fheroes2::GameMode Game::Load( const std::string & filePath )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
+    // The file might be being written by the worker thread at the moment.
+    saveFileWriter.waitForCompletion();
+
     const auto showGenericErrorMessage = []() { fheroes2::showStandardTextMessage( _( "Error" ), _( "The save file is corrupted." ), Dialog::OK ); };
 
     StreamFile fileStream;
@@ -227,10 +441,11 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
         return fheroes2::GameMode::CANCEL;
     }
 
-    RWStreamBuf dataStream;
+    // The game data is unzipped while it is being read so the whole uncompressed data is never kept in memory.
+    Compression::UnzipStream dataStream( fileStream );
     dataStream.setBigendian( true );
 
-    if ( !Compression::unzipStream( fileStream, dataStream ) ) {
+    if ( dataStream.fail() ) {
         showGenericErrorMessage();
         return fheroes2::GameMode::CANCEL;
     }
@@ -243,6 +458,10 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
         return fheroes2::GameMode::CANCEL;
     }
 
+    // The game data is read directly into the current game, but the checksum of the zipped data is verified only once all of it has been
+    // unzipped. The current game is restored if the save file turns out to be corrupted.
+    CurrentGameRestorer currentGameRestorer;
+
     dataStream >> World::Get() >> conf >> GameOver::Result::Get();
     if ( dataStream.fail() ) {
         showGenericErrorMessage();
@@ -263,11 +482,13 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 
     uint16_t endOfDataMarker = 0;
     dataStream >> endOfDataMarker;
-    if ( dataStream.fail() || endOfDataMarker != SAV2ID3 ) {
+    if ( dataStream.fail() || endOfDataMarker != SAV2ID3 || !dataStream.verify() ) {
         showGenericErrorMessage();
         return fheroes2::GameMode::CANCEL;
     }
 
+    currentGameRestorer.disable();
+
     // Settings should contain the full path to the current map file, if this map is available
     conf.getCurrentMapInfo().filename = Settings::GetLastFile( "maps", System::GetFileName( conf.getCurrentMapInfo().filename ) );
 
@@ -302,6 +523,16 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 }
 
 bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo )
+{
+    int gameType = 0;
+    if ( !LoadSAV2FileInfo( std::move( filePath ), fileInfo, gameType ) ) {
+        return false;
+    }
+
+    return ( Settings::Get().GameType() & gameType ) != 0;
+}
+
+bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo, int & gameType )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
@@ -341,12 +572,9 @@ bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo )
         return false;
     }
 
-    if ( ( Settings::Get().GameType() & header.gameType ) == 0 ) {
-        return false;
-    }
-
     fileInfo = std::move( header.info );
     fileInfo.filename = std::move( filePath );
+    gameType = header.gameType;
 
     return true;
 }
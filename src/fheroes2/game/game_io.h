@@ -46,13 +46,26 @@ namespace Game
     std::string GetSaveFileExtension();
     std::string GetSaveFileExtension( const int gameType );
 
+    // Serializes the game and passes it to the worker thread which compresses and writes the autosave file.
+    // Returns false if the game could not be serialized. Failures of writing are reported by checkAutoSaveFailure().
     bool AutoSave();
+
+    // Writes the save file right away after all pending autosave files are written.
     bool Save( const std::string & filePath, const bool autoSave = false );
 
+    // Returns true if writing of any autosave file has failed since the previous call of this function.
+    bool checkAutoSaveFailure();
+
+    // Waits until all pending autosave files are written and stops the worker thread. Must be called before the application exits.
+    void stopAutoSaveWriter();
+
     // Returns GameMode::CANCEL in case of failure.
     fheroes2::GameMode Load( const std::string & filePath );
 
     bool LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo );
 
+    // Reads information about the save file and the type of the saved game without checking whether the save file matches the type of the current game.
+    bool LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo, int & gameType );
+
     bool SaveCompletedCampaignScenario();
 }
@@ -433,7 +433,7 @@ fheroes2::GameMode GameOver::Result::checkGameOver()
         if ( !world.GetKingdom( color ).isPlay() ) {
             // This notification should always be displayed for the AI players. For human players, this should only be displayed in a multiplayer game for a
             // human player who is not currently active - in all other cases, the "you have been eliminated" dialog should be displayed.
-            if ( !( color & humanColors ) || ( !isSinglePlayer && color != currentColor ) ) {
+            if ( !Game::isHeadlessMode() && ( !( color & humanColors ) || ( !isSinglePlayer && color != currentColor ) ) ) {
                 Game::DialogPlayers( color, _( "Major Event!" ), _( "%{color} player has been vanquished!" ) );
             }
 
@@ -444,6 +444,20 @@ fheroes2::GameMode GameOver::Result::checkGameOver()
         }
     }
 
+    if ( humanColors == 0 ) {
+        // Only AI players take part in games in the headless mode. Victory and loss conditions of a map are checked only for human players,
+        // so such a game is over when there is only one kingdom left.
+        assert( Game::isHeadlessMode() );
+
+        if ( Color::Count( colors ) > 1 ) {
+            return fheroes2::GameMode::CANCEL;
+        }
+
+        result = GameOver::WINS_ALL;
+
+        return fheroes2::GameMode::MAIN_MENU;
+    }
+
     if ( isSinglePlayer ) {
         assert( activeHumanColors <= 1 );
 
@@ -87,12 +87,6 @@
 
 namespace
 {
-    bool SortPlayers( const Player * player1, const Player * player2 )
-    {
-        return ( player1->isControlHuman() && !player2->isControlHuman() )
-               || ( ( player1->isControlHuman() == player2->isControlHuman() ) && ( player1->GetColor() < player2->GetColor() ) );
-    }
-
     // Get colors value of players to use in fog directions update.
     // For human allied AI returns colors of this alliance, for hostile AI - colors of all human players and their allies.
     int32_t hotSeatAIFogColors( const Player * player )
@@ -725,8 +719,7 @@ fheroes2::GameMode Interface::AdventureMap::StartGame()
     GameOver::Result & gameResult = GameOver::Result::Get();
     fheroes2::GameMode res = fheroes2::GameMode::END_TURN;
 
-    std::vector<Player *> sortedPlayers = conf.GetPlayers().getVector();
-    std::sort( sortedPlayers.begin(), sortedPlayers.end(), SortPlayers );
+    const std::vector<Player *> sortedPlayers = conf.GetPlayers().getPlayersInTurnOrder();
     if ( !isLoadedFromSave || world.CountDay() == 1 ) {
         // Clear fog around heroes, castles and mines for all players when starting a new map or if the save was done at the first day.
         for ( const Player * player : sortedPlayers ) {
@@ -987,6 +980,11 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         }
     }
 
+    // Autosave files are written in the background so a failure is reported at the beginning of the next turn of a human player.
+    if ( Game::checkAutoSaveFailure() ) {
+        fheroes2::showStandardTextMessage( _( "Warning" ), _( "The game could not be autosaved." ), Dialog::OK );
+    }
+
     GameOver::Result & gameResult = GameOver::Result::Get();
 
     // Check if the game is over at the beginning of each human-controlled player's turn
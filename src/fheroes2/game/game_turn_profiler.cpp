@@ -0,0 +1,62 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "game_turn_profiler.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+namespace
+{
+    // Phase timers are not bound to the main thread so the time is accumulated atomically.
+    std::array<std::atomic<uint64_t>, 3> phaseTimeUs{};
+
+    size_t getPhaseIndex( const Game::TurnProfiler::Phase phase )
+    {
+        const size_t index = static_cast<size_t>( phase );
+        assert( index < phaseTimeUs.size() );
+
+        return index;
+    }
+}
+
+namespace Game::TurnProfiler
+{
+    PhaseTimer::~PhaseTimer()
+    {
+        const auto time = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - _startTime );
+
+        phaseTimeUs[getPhaseIndex( _phase )].fetch_add( static_cast<uint64_t>( time.count() ), std::memory_order_relaxed );
+    }
+
+    uint64_t getPhaseTimeUs( const Phase phase )
+    {
+        return phaseTimeUs[getPhaseIndex( phase )].load( std::memory_order_relaxed );
+    }
+
+    void reset()
+    {
+        for ( std::atomic<uint64_t> & time : phaseTimeUs ) {
+            time.store( 0, std::memory_order_relaxed );
+        }
+    }
+}
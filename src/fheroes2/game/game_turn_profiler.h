@@ -0,0 +1,59 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Accumulates wall time spent in the main phases of game turns. The accumulated time is used to track performance of AI-only games.
+// Phases can be nested: the time of a battle is also included in the time of the hero phase and the kingdom phase.
+namespace Game::TurnProfiler
+{
+    enum class Phase : int
+    {
+        KINGDOM,
+        HEROES,
+        BATTLE
+    };
+
+    class PhaseTimer
+    {
+    public:
+        explicit PhaseTimer( const Phase phase )
+            : _phase( phase )
+            , _startTime( std::chrono::steady_clock::now() )
+        {}
+
+        PhaseTimer( const PhaseTimer & ) = delete;
+        PhaseTimer & operator=( const PhaseTimer & ) = delete;
+
+        ~PhaseTimer();
+
+    private:
+        const Phase _phase;
+        const std::chrono::time_point<std::chrono::steady_clock> _startTime;
+    };
+
+    // Returns the total time in microseconds spent in the given phase since the last reset.
+    uint64_t getPhaseTimeUs( const Phase phase );
+
+    void reset();
+}
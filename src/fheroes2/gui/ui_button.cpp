@@ -1004,7 +1004,7 @@ namespace fheroes2
 
     const char * getSupportedText( const char * untranslatedText, const FontType font )
     {
-        const char * translatedText = _( untranslatedText );
+        const char * translatedText = Translation::gettext( untranslatedText );
         return isFontAvailable( translatedText, font ) ? translatedText : untranslatedText;
     }
 
@@ -21,10 +21,12 @@
 #include "ui_text.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <utility>
 
 #include "agg_image.h"
 #include "icn.h"
@@ -239,11 +241,100 @@ namespace
         return size;
     }
 
+    // All characters of a font are packed into a single image so a text line is rendered by one call of BlitRegions().
+    // Only images of characters are stored: their offsets can be temporarily changed, for example, by ButtonFontOffsetRestorer
+    // so they are always taken from the font sprites.
+    class FontAtlas
+    {
+    public:
+        void build( const fheroes2::FontCharHandler & charHandler )
+        {
+            // Invalid characters share the same '?' sprite so only unique sprites are packed.
+            std::map<const fheroes2::Sprite *, fheroes2::Rect> uniqueGlyphs;
+
+            int32_t offsetX = 0;
+            int32_t offsetY = 0;
+            int32_t shelfHeight = 0;
+            int32_t atlasWidth = 0;
+
+            for ( size_t character = 0; character < _glyphs.size(); ++character ) {
+                const fheroes2::Sprite & sprite = charHandler.getSprite( static_cast<uint8_t>( character ) );
+
+                auto [iter, isEmplaced] = uniqueGlyphs.try_emplace( &sprite );
+                if ( isEmplaced ) {
+                    if ( offsetX > 0 && offsetX + sprite.width() > maxAtlasWidth ) {
+                        offsetX = 0;
+                        offsetY += shelfHeight;
+                        shelfHeight = 0;
+                    }
+
+                    iter->second = { offsetX, offsetY, sprite.width(), sprite.height() };
+
+                    offsetX += sprite.width();
+                    shelfHeight = std::max( shelfHeight, sprite.height() );
+                    atlasWidth = std::max( atlasWidth, offsetX );
+                }
+
+                _glyphs[character] = iter->second;
+            }
+
+            _image = {};
+            _image.resize( atlasWidth, offsetY + shelfHeight );
+            // Areas which do not belong to any character are transparent.
+            _image.reset();
+
+            for ( const auto & [sprite, source] : uniqueGlyphs ) {
+                fheroes2::Copy( *sprite, 0, 0, _image, source.x, source.y, source.width, source.height );
+            }
+        }
+
+        const fheroes2::Image & image() const
+        {
+            return _image;
+        }
+
+        const fheroes2::Rect & getGlyph( const uint8_t character ) const
+        {
+            return _glyphs[character];
+        }
+
+    private:
+        static constexpr int32_t maxAtlasWidth = 512;
+
+        fheroes2::Image _image;
+        std::array<fheroes2::Rect, 256> _glyphs;
+    };
+
+    const FontAtlas & getFontAtlas( const fheroes2::FontCharHandler & charHandler )
+    {
+        // Atlases are rebuilt every time font images are replaced, for example, when the language is changed.
+        static std::map<std::pair<fheroes2::FontSize, fheroes2::FontColor>, std::pair<uint32_t, FontAtlas>> fontAtlases;
+
+        const fheroes2::FontType & fontType = charHandler.getFontType();
+
+        auto [iter, isEmplaced] = fontAtlases.try_emplace( { fontType.size, fontType.color } );
+        auto & [version, atlas] = iter->second;
+
+        if ( isEmplaced || version != fheroes2::AGG::getAlphabetVersion() ) {
+            atlas.build( charHandler );
+
+            // Fonts are generated on their first access so the version can be changed while building the atlas.
+            version = fheroes2::AGG::getAlphabetVersion();
+        }
+
+        return atlas;
+    }
+
     int32_t renderSingleLine( const uint8_t * data, const int32_t size, const int32_t x, const int32_t y, fheroes2::Image & output, const fheroes2::Rect & imageRoi,
                               const fheroes2::FontCharHandler & charHandler )
     {
         assert( data != nullptr && size > 0 && !output.empty() );
 
+        const FontAtlas & atlas = getFontAtlas( charHandler );
+
+        std::vector<fheroes2::ImageRegion> glyphRegions;
+        glyphRegions.reserve( static_cast<size_t>( size ) );
+
         int32_t offsetX = x;
 
         const int32_t spaceCharWidth = charHandler.getSpaceCharWidth();
@@ -263,18 +354,16 @@ namespace
                 continue;
             }
 
-            const fheroes2::Sprite & charSprite = charHandler.getSprite( *data );
-            assert( !charSprite.empty() );
-
-            const fheroes2::Rect charRoi{ offsetX + charSprite.x(), y + charSprite.y(), charSprite.width(), charSprite.height() };
-
-            const fheroes2::Rect overlappedRoi = imageRoi ^ charRoi;
+            const fheroes2::Sprite & sprite = charHandler.getSprite( *data );
+            const fheroes2::Rect & glyph = atlas.getGlyph( *data );
+            assert( glyph.width == sprite.width() && glyph.height == sprite.height() );
 
-            fheroes2::Blit( charSprite, overlappedRoi.x - charRoi.x, overlappedRoi.y - charRoi.y, output, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width,
-                            overlappedRoi.height );
-            offsetX += charSprite.width() + charSprite.x();
+            glyphRegions.push_back( { glyph, { offsetX + sprite.x(), y + sprite.y() } } );
+            offsetX += sprite.x() + sprite.width();
         }
 
+        fheroes2::BlitRegions( atlas.image(), glyphRegions, output, imageRoi );
+
         return offsetX;
     }
 
@@ -321,6 +410,13 @@ namespace
 
         return std::make_unique<fheroes2::LanguageSwitcher>( language.value() );
     }
+
+    // Returns the language which is used to render the given text.
+    fheroes2::SupportedLanguage getTextLanguage( const fheroes2::TextBase & text )
+    {
+        const auto & language = text.getLanguage();
+        return language ? language.value() : fheroes2::getCurrentLanguage();
+    }
 }
 
 namespace fheroes2
@@ -371,11 +467,7 @@ namespace fheroes2
             return 0;
         }
 
-        const auto languageSwitcher = getLanguageSwitcher( *this );
-        const int32_t fontHeight = height();
-
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, fontHeight, false );
+        const std::vector<TextLineInfo> & lineInfos = _getCachedTextLineInfos( maxWidth );
 
         if ( lineInfos.size() == 1 ) {
             // This is a single-line message.
@@ -388,6 +480,13 @@ namespace fheroes2
                 ->lineWidth;
         }
 
+        if ( _layoutCache.fittedWidth ) {
+            return _layoutCache.fittedWidth.value();
+        }
+
+        const auto languageSwitcher = getLanguageSwitcher( *this );
+        const int32_t fontHeight = height();
+
         // This is a multi-line message. Optimize it to fit the text evenly to the same number of lines.
         int32_t startWidth = getMaxWordWidth( reinterpret_cast<const uint8_t *>( _text.data() ), static_cast<int32_t>( _text.size() ), _fontType );
         int32_t endWidth = maxWidth;
@@ -405,6 +504,8 @@ namespace fheroes2
             endWidth = currentWidth;
         }
 
+        _layoutCache.fittedWidth = endWidth;
+
         return endWidth;
     }
 
@@ -414,13 +515,7 @@ namespace fheroes2
             return 0;
         }
 
-        const auto languageSwitcher = getLanguageSwitcher( *this );
-        const int32_t fontHeight = height();
-
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, fontHeight, false );
-
-        return lineInfos.back().offsetY + fontHeight;
+        return _getCachedTextLineInfos( maxWidth ).back().offsetY + getFontHeight( _fontType.size );
     }
 
     int32_t Text::rows( const int32_t maxWidth ) const
@@ -429,11 +524,7 @@ namespace fheroes2
             return 0;
         }
 
-        const auto languageSwitcher = getLanguageSwitcher( *this );
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, height(), false );
-
-        return static_cast<int32_t>( lineInfos.size() );
+        return static_cast<int32_t>( _getCachedTextLineInfos( maxWidth ).size() );
     }
 
     Rect Text::area() const
@@ -473,10 +564,9 @@ namespace fheroes2
             return;
         }
 
-        const auto languageSwitcher = getLanguageSwitcher( *this );
+        const std::vector<TextLineInfo> & lineInfos = _getCachedTextLineInfos( maxWidth );
 
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, height(), false );
+        const auto languageSwitcher = getLanguageSwitcher( *this );
 
         const uint8_t * data = reinterpret_cast<const uint8_t *>( _text.data() );
         const FontCharHandler charHandler( _fontType );
@@ -521,6 +611,30 @@ namespace fheroes2
 
         _text.resize( maxCharacterCount );
         _text += truncationSymbol;
+
+        _resetLayoutCache();
+    }
+
+    const std::vector<TextLineInfo> & Text::_getCachedTextLineInfos( const int32_t maxWidth ) const
+    {
+        assert( !_text.empty() );
+
+        const SupportedLanguage language = getTextLanguage( *this );
+        if ( _isLayoutCached( maxWidth, language ) ) {
+            return _layoutCache.lineInfos;
+        }
+
+        const auto languageSwitcher = getLanguageSwitcher( *this );
+
+        _layoutCache.lineInfos.clear();
+        _getTextLineInfos( _layoutCache.lineInfos, maxWidth, getFontHeight( _fontType.size ), false );
+
+        _layoutCache.maxWidth = maxWidth;
+        _layoutCache.language = language;
+        _layoutCache.isValid = true;
+        _layoutCache.fittedWidth.reset();
+
+        return _layoutCache.lineInfos;
     }
 
     void Text::_getTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const
@@ -989,6 +1103,8 @@ namespace fheroes2
     {
         if ( !text._text.empty() ) {
             _texts.emplace_back( std::move( text ) );
+
+            _resetLayoutCache();
         }
     }
 
@@ -1015,10 +1131,7 @@ namespace fheroes2
 
     int32_t MultiFontText::width( const int32_t maxWidth ) const
     {
-        const int32_t maxFontHeight = height();
-
-        std::vector<TextLineInfo> lineInfos;
-        _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
+        const std::vector<TextLineInfo> & lineInfos = _getCachedMultiFontTextLineInfos( maxWidth );
 
         int32_t maxRowWidth = lineInfos.front().lineWidth;
         for ( const TextLineInfo & lineInfo : lineInfos ) {
@@ -1030,12 +1143,7 @@ namespace fheroes2
 
     int32_t MultiFontText::height( const int32_t maxWidth ) const
     {
-        const int32_t maxFontHeight = height();
-
-        std::vector<TextLineInfo> lineInfos;
-        _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
-
-        return lineInfos.back().offsetY + maxFontHeight;
+        return _getCachedMultiFontTextLineInfos( maxWidth ).back().offsetY + height();
     }
 
     int32_t MultiFontText::rows( const int32_t maxWidth ) const
@@ -1044,10 +1152,7 @@ namespace fheroes2
             return 0;
         }
 
-        const int32_t maxFontHeight = height();
-
-        std::vector<TextLineInfo> lineInfos;
-        _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
+        const std::vector<TextLineInfo> & lineInfos = _getCachedMultiFontTextLineInfos( maxWidth );
 
         if ( lineInfos.empty() ) {
             return 0;
@@ -1113,10 +1218,7 @@ namespace fheroes2
             return;
         }
 
-        const int32_t maxFontHeight = height();
-
-        std::vector<TextLineInfo> lineInfos;
-        _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
+        const std::vector<TextLineInfo> & lineInfos = _getCachedMultiFontTextLineInfos( maxWidth );
 
         if ( lineInfos.empty() ) {
             return;
@@ -1190,6 +1292,24 @@ namespace fheroes2
         }
     }
 
+    const std::vector<TextLineInfo> & MultiFontText::_getCachedMultiFontTextLineInfos( const int32_t maxWidth ) const
+    {
+        // Texts with no explicitly set language are rendered using the current language.
+        const SupportedLanguage language = getCurrentLanguage();
+        if ( _isLayoutCached( maxWidth, language ) ) {
+            return _layoutCache.lineInfos;
+        }
+
+        _layoutCache.lineInfos.clear();
+        _getMultiFontTextLineInfos( _layoutCache.lineInfos, maxWidth, height() );
+
+        _layoutCache.maxWidth = maxWidth;
+        _layoutCache.language = language;
+        _layoutCache.isValid = true;
+
+        return _layoutCache.lineInfos;
+    }
+
     FontCharHandler::FontCharHandler( const FontType fontType )
         : _fontType( fontType )
         , _charLimit( getCharacterLimit( fontType.size ) )
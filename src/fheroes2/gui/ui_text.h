@@ -171,6 +171,7 @@ namespace fheroes2
         void setUniformVerticalAlignment( const bool isUniform )
         {
             _isUniformedVerticalAlignment = isUniform;
+            _layoutCache.fittedWidth.reset();
         }
 
         const std::optional<SupportedLanguage> & getLanguage() const
@@ -179,8 +180,32 @@ namespace fheroes2
         }
 
     protected:
+        // Multi-line texts are often redrawn without any changes so their line layout is kept until the text is changed.
+        struct LineLayoutCache
+        {
+            std::vector<TextLineInfo> lineInfos;
+            int32_t maxWidth{ 0 };
+            SupportedLanguage language{};
+            bool isValid{ false };
+
+            // The width of the text evenly fitted into the same number of lines. It is calculated only on demand.
+            std::optional<int32_t> fittedWidth;
+        };
+
+        bool _isLayoutCached( const int32_t maxWidth, const SupportedLanguage language ) const
+        {
+            return _layoutCache.isValid && _layoutCache.maxWidth == maxWidth && _layoutCache.language == language;
+        }
+
+        void _resetLayoutCache()
+        {
+            _layoutCache.isValid = false;
+        }
+
         std::optional<SupportedLanguage> _language;
 
+        mutable LineLayoutCache _layoutCache;
+
         bool _isUniformedVerticalAlignment{ true };
     };
 
@@ -235,6 +260,8 @@ namespace fheroes2
             _text = std::move( text );
             _fontType = fontType;
             _language = std::nullopt;
+
+            _resetLayoutCache();
         }
 
         void set( std::string text, const FontType fontType, const std::optional<SupportedLanguage> language )
@@ -242,6 +269,8 @@ namespace fheroes2
             _text = std::move( text );
             _fontType = fontType;
             _language = language;
+
+            _resetLayoutCache();
         }
 
         // This method modifies the underlying text and ends it with '...' if it is longer than the provided width.
@@ -256,6 +285,8 @@ namespace fheroes2
         void keepLineTrailingSpaces()
         {
             _keepLineTrailingSpaces = true;
+
+            _resetLayoutCache();
         }
 
     protected:
@@ -264,6 +295,9 @@ namespace fheroes2
         // The 'keepTextTrailingSpaces' is used to take into account all the spaces at the text end in example when you want to join multiple texts in multi-font texts.
         void _getTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const;
 
+        // Returns the line layout of this text limited by the given width. The text must not be empty.
+        const std::vector<TextLineInfo> & _getCachedTextLineInfos( const int32_t maxWidth ) const;
+
         std::string _text;
 
         FontType _fontType;
@@ -292,6 +326,8 @@ namespace fheroes2
             _cursorPositionInText = cursorPosition;
             _visibleTextLength = static_cast<int32_t>( _text.size() );
 
+            _resetLayoutCache();
+
             _updateCursorAreaInText();
         }
 
@@ -369,6 +405,8 @@ namespace fheroes2
     private:
         void _getMultiFontTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight ) const;
 
+        const std::vector<TextLineInfo> & _getCachedMultiFontTextLineInfos( const int32_t maxWidth ) const;
+
         std::vector<Text> _texts;
     };
 
@@ -389,6 +427,11 @@ namespace fheroes2
             return _spaceCharWidth;
         }
 
+        const FontType & getFontType() const
+        {
+            return _fontType;
+        }
+
     private:
         // Returns true if character is valid for the current code page, excluding space (' ') and new line ('\n').
         bool _isValid( const uint8_t character ) const;
@@ -103,4 +103,9 @@ namespace fheroes2::h2d
     {
         return readImageFromH2D( reader, name, image );
     }
+
+    uint32_t getChecksum()
+    {
+        return reader.getChecksum();
+    }
 }
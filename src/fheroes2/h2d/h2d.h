@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace fheroes2
@@ -39,5 +40,8 @@ namespace fheroes2
         };
 
         bool readImage( const std::string & name, Sprite & image );
+
+        // Returns the checksum of the content of the H2D file.
+        uint32_t getChecksum();
     }
 }
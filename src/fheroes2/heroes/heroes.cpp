@@ -239,7 +239,7 @@ const char * Heroes::GetName( int heroid )
             // Debug hero. Should not be used anywhere outside the development!
             "Debug Hero" };
 
-    return _( names[heroid] );
+    return Translation::gettext( names[heroid] );
 }
 
 Heroes::Heroes()
@@ -284,7 +284,7 @@ Heroes::Heroes( int heroid, int rc )
     , _attackedMonsterTileIndex( -1 )
     , _aiRole( Role::HUNTER )
 {
-    name = _( Heroes::GetName( heroid ) );
+    name = Translation::gettext( Heroes::GetName( heroid ) );
 
     army.Reset( true );
 
@@ -336,7 +336,7 @@ void Kingdom::AddCastle( Castle * castle )
         }
 
         const Player * player = Settings::Get().GetPlayers().GetCurrent();
-        if ( player && player->isColor( GetColor() ) ) {
+        if ( player && player->isColor( GetColor() ) && !Game::isHeadlessMode() ) {
             Interface::AdventureMap::Get().GetIconsPanel().resetIcons( ICON_CASTLES );
         }
     }
@@ -763,6 +763,9 @@ void Kingdom::openOverviewDialog()
 {
     Game::SetUpdateSoundsOnFocusUpdate( false );
 
+    // These images are decoded in the background while the game screen is fading out.
+    fheroes2::AGG::prefetchICNs( { ICN::OVERBACK, ICN::OVERVIEW, ICN::SCROLL } );
+
     fheroes2::Display & display = fheroes2::Display::instance();
 
     // setup cursor
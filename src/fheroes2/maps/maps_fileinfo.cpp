@@ -42,6 +42,7 @@
 #include "game_over.h"
 #include "logging.h"
 #include "map_format_info.h"
+#include "maps_fileinfo_index.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "mp2.h"
@@ -100,23 +101,28 @@ namespace
             = isOriginalMapFormat
               && ( fheroes2::getCurrentLanguage() == fheroes2::SupportedLanguage::French && fheroes2::getResourceLanguage() == fheroes2::SupportedLanguage::French );
 
-        for ( const std::string & mapFile : mapFiles ) {
-            Maps::FileInfo fi;
-
+        // Maps are read as for the Editor so the same index can be used in all cases. Map files can be read in parallel.
+        const Maps::FileInfoReader reader = [isOriginalMapFormat]( const std::string & filePath, Maps::IndexedFileInfo & fileInfo ) {
             if ( isOriginalMapFormat ) {
-                if ( !fi.readMP2Map( mapFile, isForEditor ) ) {
-                    continue;
-                }
-            }
-            else {
-                if ( !fi.readResurrectionMap( mapFile, isForEditor ) ) {
-                    continue;
-                }
+                return fileInfo.info.readMP2Map( filePath, true );
             }
 
+            return fileInfo.info.readResurrectionMap( filePath, true );
+        };
+
+        std::vector<Maps::IndexedFileInfo> mapInfos = Maps::getIndexedFileInfos( isOriginalMapFormat ? "mp2_maps" : "fh2m_maps", mapFiles, reader, true );
+
+        for ( Maps::IndexedFileInfo & mapInfo : mapInfos ) {
+            Maps::FileInfo & fi = mapInfo.info;
+
             if ( !isForEditor ) {
                 assert( humanPlayerCount >= 1 );
 
+                if ( fi.colorsAvailableForHumans == 0 ) {
+                    // This is not a valid map since no human players exist so it cannot be played.
+                    continue;
+                }
+
                 const int humanOnlyColorsCount = Color::Count( fi.HumanOnlyColors() );
                 if ( humanOnlyColorsCount > humanPlayerCount ) {
                     // This map requires more human-only players than needed.
@@ -141,7 +147,7 @@ namespace
                 }
             }
 
-            uniqueMaps.try_emplace( System::GetFileName( mapFile ), std::move( fi ) );
+            uniqueMaps.try_emplace( System::GetFileName( fi.filename ), std::move( fi ) );
         }
 
         MapsFileInfoList result;
@@ -0,0 +1,241 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "maps_fileinfo_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include "dir.h"
+#include "game_io.h"
+#include "logging.h"
+#include "save_format_version.h"
+#include "serialize.h"
+#include "system.h"
+#include "thread.h"
+#include "tools.h"
+
+namespace
+{
+    const uint32_t indexFileMagic = 0x58444946; // "FIDX"
+
+    // Increase this value every time the layout of the index file is changed.
+    const uint32_t indexFileFormatVersion = 1;
+
+    struct IndexRecord
+    {
+        uint64_t fileSize{ 0 };
+        int64_t modificationTime{ 0 };
+
+        // False if the file is not a valid map or save file.
+        bool isValid{ false };
+
+        Maps::IndexedFileInfo fileInfo;
+    };
+
+    using FileIndex = std::map<std::string, IndexRecord>;
+
+    OStreamBase & operator<<( OStreamBase & stream, const IndexRecord & record )
+    {
+        const uint64_t modificationTime = static_cast<uint64_t>( record.modificationTime );
+
+        stream << static_cast<uint32_t>( record.fileSize >> 32 ) << static_cast<uint32_t>( record.fileSize ) << static_cast<uint32_t>( modificationTime >> 32 )
+               << static_cast<uint32_t>( modificationTime ) << record.isValid;
+
+        if ( record.isValid ) {
+            stream << record.fileInfo.info << record.fileInfo.gameType;
+        }
+
+        return stream;
+    }
+
+    IStreamBase & operator>>( IStreamBase & stream, IndexRecord & record )
+    {
+        uint32_t fileSizeHigh = 0;
+        uint32_t fileSizeLow = 0;
+        uint32_t modificationTimeHigh = 0;
+        uint32_t modificationTimeLow = 0;
+
+        stream >> fileSizeHigh >> fileSizeLow >> modificationTimeHigh >> modificationTimeLow >> record.isValid;
+
+        record.fileSize = ( static_cast<uint64_t>( fileSizeHigh ) << 32 ) | fileSizeLow;
+        record.modificationTime = static_cast<int64_t>( ( static_cast<uint64_t>( modificationTimeHigh ) << 32 ) | modificationTimeLow );
+
+        if ( record.isValid ) {
+            stream >> record.fileInfo.info >> record.fileInfo.gameType;
+        }
+
+        return stream;
+    }
+
+    std::string getIndexFilePath( const std::string & indexName )
+    {
+        return System::concatPath( System::GetCacheDirectory( "fheroes2" ), indexName + ".index" );
+    }
+
+    FileIndex loadIndex( const std::string & filePath )
+    {
+        if ( !System::IsFile( filePath ) ) {
+            return {};
+        }
+
+        StreamFile file;
+        if ( !file.open( filePath, "rb" ) ) {
+            return {};
+        }
+
+        const uint32_t magic = file.getLE32();
+        const uint32_t formatVersion = file.getLE32();
+        const uint16_t saveFormatVersion = file.getLE16();
+        const uint32_t dataChecksum = file.getLE32();
+
+        // File information is stored in the same way as in save files so the index of an older version of the game is not used.
+        if ( file.fail() || magic != indexFileMagic || formatVersion != indexFileFormatVersion || saveFormatVersion != CURRENT_FORMAT_VERSION ) {
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "File index " << filePath << " is outdated." )
+            return {};
+        }
+
+        ROStreamBuf data = file.getStreamBuf();
+        if ( fheroes2::calculateCRC32( data.data(), data.size() ) != dataChecksum ) {
+            ERROR_LOG( "File index " << filePath << " is corrupted." )
+            return {};
+        }
+
+        FileIndex index;
+
+        const uint16_t currentSaveFileVersion = Game::GetVersionOfCurrentSaveFile();
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+        data >> index;
+
+        Game::SetVersionOfCurrentSaveFile( currentSaveFileVersion );
+
+        if ( data.fail() ) {
+            ERROR_LOG( "File index " << filePath << " is corrupted." )
+            return {};
+        }
+
+        // Only the name of a file is serialized as a part of file information.
+        for ( auto & [path, record] : index ) {
+            record.fileInfo.info.filename = path;
+        }
+
+        return index;
+    }
+
+    void saveIndex( const std::string & filePath, const FileIndex & index )
+    {
+        RWStreamBuf data;
+        data << index;
+
+        System::MakeDirectory( System::GetParentDirectory( filePath ) );
+
+        const std::string tempFilePath = filePath + ".tmp";
+
+        {
+            StreamFile file;
+            if ( !file.open( tempFilePath, "wb" ) ) {
+                ERROR_LOG( "Unable to create the file index " << tempFilePath )
+                return;
+            }
+
+            file.putLE32( indexFileMagic );
+            file.putLE32( indexFileFormatVersion );
+            file.putLE16( CURRENT_FORMAT_VERSION );
+            file.putLE32( fheroes2::calculateCRC32( data.data(), data.size() ) );
+            file.putRaw( data.data(), data.size() );
+
+            if ( file.fail() ) {
+                ERROR_LOG( "Unable to write the file index " << tempFilePath )
+                file.close();
+                System::Unlink( tempFilePath );
+                return;
+            }
+        }
+
+        if ( !System::Rename( tempFilePath, filePath ) ) {
+            ERROR_LOG( "Unable to replace the file index " << filePath )
+            System::Unlink( tempFilePath );
+        }
+    }
+}
+
+namespace Maps
+{
+    std::vector<IndexedFileInfo> getIndexedFileInfos( const std::string & indexName, const ListFiles & files, const FileInfoReader & reader,
+                                                      const bool isReaderThreadSafe )
+    {
+        const std::string indexFilePath = getIndexFilePath( indexName );
+
+        FileIndex oldIndex = loadIndex( indexFilePath );
+        FileIndex newIndex;
+
+        // Records of files which have been changed since they were indexed or which have not been indexed yet.
+        std::vector<std::pair<const std::string *, IndexRecord *>> outdatedRecords;
+
+        for ( const std::string & filePath : files ) {
+            IndexRecord record;
+            if ( !System::GetFileSizeAndModificationTime( filePath, record.fileSize, record.modificationTime ) ) {
+                continue;
+            }
+
+            auto oldRecordIter = oldIndex.find( filePath );
+            if ( oldRecordIter != oldIndex.end() && oldRecordIter->second.fileSize == record.fileSize
+                 && oldRecordIter->second.modificationTime == record.modificationTime ) {
+                newIndex.try_emplace( filePath, std::move( oldRecordIter->second ) );
+                continue;
+            }
+
+            auto [newRecordIter, isInserted] = newIndex.try_emplace( filePath, std::move( record ) );
+            if ( isInserted ) {
+                outdatedRecords.emplace_back( &newRecordIter->first, &newRecordIter->second );
+            }
+        }
+
+        const auto readFileInfo = [&outdatedRecords, &reader]( const size_t recordIdx, const uint32_t /* threadIdx */ ) {
+            auto & [filePath, record] = outdatedRecords[recordIdx];
+
+            record->isValid = reader( *filePath, record->fileInfo );
+        };
+
+        MultiThreading::parallelFor( outdatedRecords.size(), isReaderThreadSafe ? MultiThreading::getMaxParallelThreads() : 1, readFileInfo );
+
+        // Records of deleted files are removed from the index as well.
+        if ( !outdatedRecords.empty() || oldIndex.size() != newIndex.size() ) {
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "File index " << indexFilePath << ": " << outdatedRecords.size() << " of " << newIndex.size() << " files have been read." )
+
+            saveIndex( indexFilePath, newIndex );
+        }
+
+        std::vector<IndexedFileInfo> result;
+        result.reserve( files.size() );
+
+        for ( const std::string & filePath : files ) {
+            auto iter = newIndex.find( filePath );
+            if ( iter != newIndex.end() && iter->second.isValid ) {
+                result.emplace_back( iter->second.fileInfo );
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,49 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "maps_fileinfo.h"
+
+struct ListFiles;
+
+namespace Maps
+{
+    struct IndexedFileInfo
+    {
+        FileInfo info;
+
+        // Type of the game, only relevant for save files.
+        int gameType{ 0 };
+    };
+
+    // Reads information about the file at the given path. Returns false if the file is not a valid map or save file.
+    using FileInfoReader = std::function<bool( const std::string & filePath, IndexedFileInfo & fileInfo )>;
+
+    // Returns information about all valid files from the given list in the same order. The information is taken from the persistent
+    // index with the given name if the size and the modification time of a file have not changed since the file was indexed. All other
+    // files are read by 'reader' (in parallel if the reader is thread-safe) and the index is updated.
+    std::vector<IndexedFileInfo> getIndexedFileInfos( const std::string & indexName, const ListFiles & files, const FileInfoReader & reader,
+                                                      const bool isReaderThreadSafe );
+}
@@ -540,7 +540,7 @@ void Maps::Tile::setBoat( const int direction, const int color )
 {
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
         // It is important to preserve the order of objects for rendering purposes. Therefore, the main object should go to the front of objects.
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.insert( _groundObjectPart.begin(), _mainObjectPart );
     }
 
     // If this assertion blows up then you are trying to put a boat on land!
@@ -907,11 +907,11 @@ void Maps::Tile::sortObjectParts()
 
     // Push everything to the container and sort it by level.
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.insert( _groundObjectPart.begin(), _mainObjectPart );
     }
 
     // Sort by internal layers.
-    _groundObjectPart.sort( []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
+    std::stable_sort( _groundObjectPart.begin(), _groundObjectPart.end(), []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
 
     if ( !_groundObjectPart.empty() ) {
         ObjectPart & highestPriorityPart = _groundObjectPart.back();
@@ -1273,8 +1273,8 @@ void Maps::Tile::updateFlag( const int color, const uint8_t objectSpriteIndex, c
     // Flag deletion or installation must be done in relation to object UID as flag is attached to the object.
     if ( color == Color::NONE ) {
         const auto isFlag = [uid]( const auto & part ) { return part._uid == uid && part.icnType == MP2::OBJ_ICN_TYPE_FLAG32; };
-        _groundObjectPart.remove_if( isFlag );
-        _topObjectPart.remove_if( isFlag );
+        _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isFlag ), _groundObjectPart.end() );
+        _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isFlag ), _topObjectPart.end() );
         return;
     }
 
@@ -1445,14 +1445,16 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
         isObjectPartRemoved = true;
     }
 
+    const auto isObjectPart = [objectUID]( const auto & v ) { return v._uid == objectUID; };
+
     size_t partCountBefore = _groundObjectPart.size();
-    _groundObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
+    _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isObjectPart ), _groundObjectPart.end() );
     if ( partCountBefore != _groundObjectPart.size() ) {
         isObjectPartRemoved = true;
     }
 
     partCountBefore = _topObjectPart.size();
-    _topObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
+    _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isObjectPart ), _topObjectPart.end() );
     if ( partCountBefore != _topObjectPart.size() ) {
         isObjectPartRemoved = true;
     }
@@ -1482,8 +1484,10 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
 
 void Maps::Tile::removeObjects( const MP2::ObjectIcnType objectIcnType )
 {
-    _groundObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
-    _topObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
+    const auto isObjectIcnType = [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; };
+
+    _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isObjectIcnType ), _groundObjectPart.end() );
+    _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isObjectIcnType ), _topObjectPart.end() );
 
     if ( _mainObjectPart.icnType == objectIcnType ) {
         _mainObjectPart = {};
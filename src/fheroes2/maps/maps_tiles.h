@@ -25,7 +25,6 @@
 
 #include <array>
 #include <cstdint>
-#include <list>
 #include <string>
 #include <vector>
 
@@ -238,17 +237,17 @@ namespace Maps
             _topObjectPart.emplace_back( ta );
         }
 
-        const std::list<ObjectPart> & getGroundObjectParts() const
+        const std::vector<ObjectPart> & getGroundObjectParts() const
         {
             return _groundObjectPart;
         }
 
-        std::list<ObjectPart> & getGroundObjectParts()
+        std::vector<ObjectPart> & getGroundObjectParts()
         {
             return _groundObjectPart;
         }
 
-        const std::list<ObjectPart> & getTopObjectParts() const
+        const std::vector<ObjectPart> & getTopObjectParts() const
         {
             return _topObjectPart;
         }
@@ -367,9 +366,11 @@ namespace Maps
 
         ObjectPart _mainObjectPart;
 
-        std::list<ObjectPart> _groundObjectPart;
+        // Most tiles have no or very few additional object parts so they are kept in contiguous memory
+        // to avoid per-part allocations and pointer chasing during rendering and passability checks.
+        std::vector<ObjectPart> _groundObjectPart;
 
-        std::list<ObjectPart> _topObjectPart;
+        std::vector<ObjectPart> _topObjectPart;
 
         int32_t _index{ 0 };
 
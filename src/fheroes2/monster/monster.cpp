@@ -781,18 +781,18 @@ uint32_t Monster::GetDwelling() const
 
 const char * Monster::GetName() const
 {
-    return _( fheroes2::getMonsterData( id ).generalStats.untranslatedName );
+    return Translation::gettext( fheroes2::getMonsterData( id ).generalStats.untranslatedName );
 }
 
 const char * Monster::GetMultiName() const
 {
-    return _( fheroes2::getMonsterData( id ).generalStats.untranslatedPluralName );
+    return Translation::gettext( fheroes2::getMonsterData( id ).generalStats.untranslatedPluralName );
 }
 
 const char * Monster::GetPluralName( uint32_t count ) const
 {
     const fheroes2::MonsterGeneralStats & generalStats = fheroes2::getMonsterData( id ).generalStats;
-    return count == 1 ? _( generalStats.untranslatedName ) : _( generalStats.untranslatedPluralName );
+    return count == 1 ? Translation::gettext( generalStats.untranslatedName ) : Translation::gettext( generalStats.untranslatedPluralName );
 }
 
 const char * Monster::getRandomRaceMonstersName( const uint32_t building )
@@ -948,9 +948,9 @@ namespace fheroes2
 
     std::string ArtifactData::getDescription( const int extraParameter ) const
     {
-        std::string description( _( untranslatedBaseDescription ) );
+        std::string description( Translation::gettext( untranslatedBaseDescription ) );
 
-        StringReplace( description, "%{name}", _( untranslatedName ) );
+        StringReplace( description, "%{name}", Translation::gettext( untranslatedName ) );
 
         std::vector<ArtifactBonus>::const_iterator foundBonus = std::find( bonuses.begin(), bonuses.end(), ArtifactBonus( ArtifactBonusType::ADD_SPELL ) );
         if ( foundBonus != bonuses.end() ) {
@@ -150,12 +150,12 @@ namespace
 
 const char * Spell::GetName() const
 {
-    return _( spells[id].name );
+    return Translation::gettext( spells[id].name );
 }
 
 const char * Spell::GetDescription() const
 {
-    return _( spells[id].description );
+    return Translation::gettext( spells[id].description );
 }
 
 uint32_t Spell::movePoints() const
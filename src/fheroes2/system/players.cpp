@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <sstream>
@@ -46,7 +47,9 @@
 namespace
 {
     std::array<Player *, maxNumOfPlayers + 1> playersArray{};
-    int humanColors{ Color::NONE };
+    // AI threads which evaluate targets for heroes in parallel read and update this value. In games without human players it is updated
+    // on every call.
+    std::atomic<int> humanColors{ Color::NONE };
 
     enum
     {
@@ -419,6 +422,18 @@ const std::vector<Player *> & Players::getVector() const
     return *this;
 }
 
+std::vector<Player *> Players::getPlayersInTurnOrder() const
+{
+    std::vector<Player *> players = getVector();
+
+    std::sort( players.begin(), players.end(), []( const Player * player1, const Player * player2 ) {
+        return ( player1->isControlHuman() && !player2->isControlHuman() )
+               || ( ( player1->isControlHuman() == player2->isControlHuman() ) && ( player1->GetColor() < player2->GetColor() ) );
+    } );
+
+    return players;
+}
+
 Player * Players::GetCurrent()
 {
     return Get( _currentColor );
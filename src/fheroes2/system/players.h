@@ -242,6 +242,9 @@ public:
 
     const std::vector<Player *> & getVector() const;
 
+    // Returns players in the order of their turns: human players go first, players of the same control type are ordered by their colors.
+    std::vector<Player *> getPlayersInTurnOrder() const;
+
     Player * GetCurrent();
     const Player * GetCurrent() const;
 
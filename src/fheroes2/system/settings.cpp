@@ -91,6 +91,33 @@ namespace
     };
 
     const int defaultSpeedDelay{ 5 };
+
+    bool setTranslation( const std::string & language )
+    {
+        if ( language.empty() ) {
+            Translation::reset();
+            return true;
+        }
+
+        // First, let's see if the translation for the requested language is already cached
+        if ( const auto [isCached, isSet] = Translation::setLanguage( language ); isCached ) {
+            return isSet;
+        }
+
+        const std::string fileName = std::string( language ).append( ".mo" );
+#if defined( MACOS_APP_BUNDLE )
+        const ListFiles translations = Settings::FindFiles( "translations", fileName, false );
+#else
+        const ListFiles translations = Settings::FindFiles( System::concatPath( "files", "lang" ), fileName, false );
+#endif
+
+        if ( translations.empty() ) {
+            ERROR_LOG( "Translation file " << fileName << " was not found." )
+        }
+
+        // If the translation for this language could not be loaded, it will still remain in the cache as invalid
+        return Translation::setLanguage( language, translations.empty() ? std::string_view{} : translations.back() );
+    }
 }
 
 std::string Settings::GetVersion()
@@ -201,6 +228,10 @@ bool Settings::Read( const std::string & filePath )
         SetHeroesMoveSpeed( config.IntParams( "heroes speed" ) );
     }
 
+    if ( config.Exists( "ai worker threads" ) ) {
+        setAIWorkerThreads( config.IntParams( "ai worker threads" ) );
+    }
+
     // scroll speed
     SetScrollSpeed( config.IntParams( "scroll speed" ) );
 
@@ -419,6 +450,9 @@ std::string Settings::String() const
     os << std::endl << "# AI movement speed: 0 - 10" << std::endl;
     os << "ai speed = " << ai_speed << std::endl;
 
+    os << std::endl << "# number of threads used by AI to evaluate targets for its heroes: 0 - 64. 0 means all available CPU cores" << std::endl;
+    os << "ai worker threads = " << _aiWorkerThreads << std::endl;
+
     os << std::endl << "# battle speed: 1 - 10" << std::endl;
     os << "battle speed = " << battle_speed << std::endl;
 
@@ -531,33 +565,14 @@ void Settings::setCurrentMapInfo( Maps::FileInfo fi )
 
 bool Settings::setGameLanguage( const std::string & language )
 {
-    fheroes2::updateAlphabet( language );
-
     _gameLanguage = language;
 
-    if ( _gameLanguage.empty() ) {
-        Translation::reset();
-        return true;
-    }
-
-    // First, let's see if the translation for the requested language is already cached
-    if ( const auto [isCached, isSet] = Translation::setLanguage( language ); isCached ) {
-        return isSet;
-    }
-
-    const std::string fileName = std::string( _gameLanguage ).append( ".mo" );
-#if defined( MACOS_APP_BUNDLE )
-    const ListFiles translations = Settings::FindFiles( "translations", fileName, false );
-#else
-    const ListFiles translations = Settings::FindFiles( System::concatPath( "files", "lang" ), fileName, false );
-#endif
+    const bool isTranslationSet = setTranslation( language );
 
-    if ( translations.empty() ) {
-        ERROR_LOG( "Translation file " << fileName << " was not found." )
-    }
+    // Language dependent resources are updated after the translation since the ICN cache of the language depends on its translation file.
+    fheroes2::updateAlphabet( language );
 
-    // If the translation for this language could not be loaded, it will still remain in the cache as invalid
-    return Translation::setLanguage( language, translations.empty() ? std::string_view{} : translations.back() );
+    return isTranslationSet;
 }
 
 void Settings::setEditorAnimation( const bool enable )
@@ -698,6 +713,11 @@ void Settings::SetAIMoveSpeed( int speed )
     ai_speed = std::clamp( speed, 0, 10 );
 }
 
+void Settings::setAIWorkerThreads( const int threads )
+{
+    _aiWorkerThreads = std::clamp( threads, 0, 64 );
+}
+
 void Settings::SetHeroesMoveSpeed( int speed )
 {
     heroes_speed = std::clamp( speed, 1, 10 );
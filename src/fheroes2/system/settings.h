@@ -121,6 +121,12 @@ public:
         return scroll_speed;
     }
 
+    // Returns the number of threads used by AI to evaluate targets for its heroes, 0 means "use all available CPU cores"
+    int getAIWorkerThreads() const
+    {
+        return _aiWorkerThreads;
+    }
+
     int GameDifficulty() const
     {
         return _gameDifficulty;
@@ -257,6 +263,8 @@ public:
     void SetHeroesMoveSpeed( int );
     // Sets the animation speed during combat in the range 1 - 10
     void SetBattleSpeed( int );
+    // Sets the number of threads used by AI to evaluate targets for its heroes in the range 0 - 64, 0 means "use all available CPU cores"
+    void setAIWorkerThreads( const int threads );
     void setBattleAutoResolve( bool enable );
     void setBattleAutoSpellcast( bool enable );
     void setBattleShowTurnOrder( const bool enable );
@@ -395,6 +403,7 @@ private:
     int ai_speed;
     int scroll_speed;
     int battle_speed;
+    int _aiWorkerThreads{ 1 };
 
     int game_type;
     ZoomLevel _viewWorldZoomLevel{ ZoomLevel::ZoomLevel1 };
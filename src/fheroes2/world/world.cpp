@@ -26,6 +26,8 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
 #include <limits>
 #include <optional>
 #include <ostream>
@@ -68,28 +70,58 @@
 
 namespace
 {
-    bool isTileBlockedForSettingMonster( const std::vector<Maps::Tile> & mapTiles, const int32_t tileId, const int32_t radius, const std::set<int32_t> & excludeTiles )
+    // Tiles near castles, heroes, monsters and tiles chosen to set monsters are blocked for setting other monsters. Every tile keeps the distance
+    // to the closest blocking tile so checking whether a tile is blocked takes constant time.
+    class MonsterPlacementMap
     {
-        const MapsIndexes & indexes = Maps::getAroundIndexes( tileId, radius );
+    public:
+        MonsterPlacementMap( const int32_t width, const int32_t height )
+            : _width( width )
+            , _height( height )
+            , _distanceToBlockingTile( static_cast<size_t>( width ) * height, noBlockingTileNearby )
+        {
+            // Do nothing.
+        }
 
-        for ( const int32_t indexId : indexes ) {
-            if ( excludeTiles.count( indexId ) > 0 ) {
-                return true;
-            }
+        void addBlockingTile( const int32_t tileId )
+        {
+            const int32_t centerX = tileId % _width;
+            const int32_t centerY = tileId / _width;
 
-            const Maps::Tile & indexedTile = mapTiles[indexId];
-            if ( indexedTile.isWater() ) {
-                continue;
-            }
+            const int32_t minTileX = std::max( centerX - maxBlockingDistance, 0 );
+            const int32_t minTileY = std::max( centerY - maxBlockingDistance, 0 );
+            const int32_t maxTileX = std::min( centerX + maxBlockingDistance + 1, _width );
+            const int32_t maxTileY = std::min( centerY + maxBlockingDistance + 1, _height );
 
-            const MP2::MapObjectType objectType = indexedTile.getMainObjectType( true );
-            if ( objectType == MP2::OBJ_CASTLE || objectType == MP2::OBJ_HERO || objectType == MP2::OBJ_MONSTER ) {
-                return true;
+            for ( int32_t tileY = minTileY; tileY < maxTileY; ++tileY ) {
+                uint8_t * distance = _distanceToBlockingTile.data() + static_cast<ptrdiff_t>( tileY ) * _width;
+
+                for ( int32_t tileX = minTileX; tileX < maxTileX; ++tileX ) {
+                    const uint8_t distanceToCenter = static_cast<uint8_t>( std::max( std::abs( tileX - centerX ), std::abs( tileY - centerY ) ) );
+                    distance[tileX] = std::min( distance[tileX], distanceToCenter );
+                }
             }
         }
 
-        return false;
-    }
+        // Returns true if there is a blocking tile around the given tile within the given radius. The tile itself is not taken into account.
+        bool isTileBlocked( const int32_t tileId, const int32_t radius ) const
+        {
+            assert( radius > 0 && radius <= maxBlockingDistance );
+
+            const uint8_t distance = _distanceToBlockingTile[tileId];
+
+            return distance > 0 && distance <= radius;
+        }
+
+    private:
+        static constexpr int32_t maxBlockingDistance = 4;
+        static constexpr uint8_t noBlockingTileNearby = maxBlockingDistance + 1;
+
+        const int32_t _width;
+        const int32_t _height;
+
+        std::vector<uint8_t> _distanceToBlockingTile;
+    };
 
     int32_t findSuitableNeighbouringTile( const std::vector<Maps::Tile> & mapTiles, const int32_t tileId, const bool allDirections, std::mt19937 & gen )
     {
@@ -510,8 +542,9 @@ bool World::LastWeek() const
 
 const Week & World::GetWeekType() const
 {
-    static auto cachedWeekDependencies = std::make_tuple( week, GetWeekSeed() );
-    static Week cachedWeek = Week::RandomWeek( FirstWeek(), GetWeekSeed() );
+    // This method can be called by AI from several threads at the same time
+    thread_local auto cachedWeekDependencies = std::make_tuple( week, GetWeekSeed() );
+    thread_local Week cachedWeek = Week::RandomWeek( FirstWeek(), GetWeekSeed() );
 
     const auto currentWeekDependencies = std::make_tuple( week, GetWeekSeed() );
 
@@ -607,7 +640,17 @@ void World::MonthOfMonstersAction( const Monster & mons )
     // Lastly monster occasionally appear on empty tiles.
     std::vector<int32_t> tetriaryTargetTiles;
 
-    std::set<int32_t> excludeTiles;
+    MonsterPlacementMap placementMap( width, height );
+
+    const auto isBlockingObject = []( const MP2::MapObjectType objectType ) {
+        return objectType == MP2::OBJ_CASTLE || objectType == MP2::OBJ_HERO || objectType == MP2::OBJ_MONSTER;
+    };
+
+    for ( const Maps::Tile & tile : vec_tiles ) {
+        if ( !tile.isWater() && isBlockingObject( tile.getMainObjectType( true ) ) ) {
+            placementMap.addBlockingTile( tile.GetIndex() );
+        }
+    }
 
     std::mt19937 seededGen( _seed + month );
 
@@ -620,24 +663,23 @@ void World::MonthOfMonstersAction( const Monster & mons )
         const int32_t tileId = tile.GetIndex();
         const MP2::MapObjectType objectType = tile.getMainObjectType( true );
 
-        if ( objectType == MP2::OBJ_CASTLE || objectType == MP2::OBJ_HERO || objectType == MP2::OBJ_MONSTER ) {
-            excludeTiles.emplace( tileId );
+        if ( isBlockingObject( objectType ) ) {
             continue;
         }
 
         if ( MP2::isInGameActionObject( objectType ) ) {
-            if ( isTileBlockedForSettingMonster( vec_tiles, tileId, 3, excludeTiles ) ) {
+            if ( placementMap.isTileBlocked( tileId, 3 ) ) {
                 continue;
             }
 
             const int32_t tileToSet = findSuitableNeighbouringTile( vec_tiles, tileId, ( tile.GetPassable() == DIRECTION_ALL ), seededGen );
             if ( tileToSet >= 0 ) {
                 primaryTargetTiles.emplace_back( tileToSet );
-                excludeTiles.emplace( tileId );
+                placementMap.addBlockingTile( tileId );
             }
         }
         else if ( tile.isRoad() ) {
-            if ( isTileBlockedForSettingMonster( vec_tiles, tileId, 4, excludeTiles ) ) {
+            if ( placementMap.isTileBlocked( tileId, 4 ) ) {
                 continue;
             }
 
@@ -648,11 +690,11 @@ void World::MonthOfMonstersAction( const Monster & mons )
             const int32_t tileToSet = findSuitableNeighbouringTile( vec_tiles, tileId, true, seededGen );
             if ( tileToSet >= 0 ) {
                 secondaryTargetTiles.emplace_back( tileToSet );
-                excludeTiles.emplace( tileId );
+                placementMap.addBlockingTile( tileId );
             }
         }
         else if ( isClearGround( tile ) ) {
-            if ( isTileBlockedForSettingMonster( vec_tiles, tileId, 4, excludeTiles ) ) {
+            if ( placementMap.isTileBlocked( tileId, 4 ) ) {
                 continue;
             }
 
@@ -663,7 +705,7 @@ void World::MonthOfMonstersAction( const Monster & mons )
             const int32_t tileToSet = findSuitableNeighbouringTile( vec_tiles, tileId, true, seededGen );
             if ( tileToSet >= 0 ) {
                 tetriaryTargetTiles.emplace_back( tileToSet );
-                excludeTiles.emplace( tileId );
+                placementMap.addBlockingTile( tileId );
             }
         }
     }
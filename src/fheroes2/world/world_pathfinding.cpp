@@ -21,6 +21,7 @@
 #include "world_pathfinding.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -28,6 +29,10 @@
 #include <tuple>
 #include <utility>
 
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
 #include "army.h"
 #include "artifact.h"
 #include "castle.h"
@@ -37,6 +42,7 @@
 #include "ground.h"
 #include "heroes.h"
 #include "kingdom.h"
+#include "logging.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
@@ -91,7 +97,7 @@ namespace
 
         const auto isTileAccessible = [color, armyStrength, minimalAdvantage, &tile]() {
             // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-            static Army tileArmy;
+            thread_local Army tileArmy;
             tileArmy.setFromTile( tile );
 
             const int tileArmyColor = tileArmy.GetColor();
@@ -309,7 +315,7 @@ namespace
 
         for ( const int32_t monsterIndex : Maps::getMonstersProtectingTile( tileIndex ) ) {
             // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-            static Army tileArmy;
+            thread_local Army tileArmy;
             tileArmy.setFromTile( world.getTile( monsterIndex ) );
 
             // Tiles guarded by too powerful wandering monsters are considered inaccessible
@@ -321,6 +327,40 @@ namespace
         return true;
     }
 
+    size_t getBucketIndex( const uint64_t key, const uint64_t lastKey )
+    {
+        assert( key >= lastKey );
+
+        // The index of the highest bit in which the key differs from the last extracted key (counting from 1), or 0 if they are equal
+        const uint64_t diff = key ^ lastKey;
+        if ( diff == 0 ) {
+            return 0;
+        }
+
+#if defined( _MSC_VER )
+        // _BitScanReverse64() is not available on 32-bit platforms.
+        unsigned long index = 0;
+        if ( _BitScanReverse( &index, static_cast<unsigned long>( diff >> 32 ) ) ) {
+            return static_cast<size_t>( index ) + 33;
+        }
+
+        _BitScanReverse( &index, static_cast<unsigned long>( diff ) );
+        return static_cast<size_t>( index ) + 1;
+#else
+        return static_cast<size_t>( 64 - __builtin_clzll( diff ) );
+#endif
+    }
+
+#if defined( WITH_DEBUG )
+    std::atomic<bool> isExplorationVerificationEnabled{ false };
+
+    // Pathfinders of AI heroes might be used by several threads at the same time.
+    std::atomic<uint64_t> verifiedEvaluationCount{ 0 };
+    std::atomic<uint64_t> verifiedNodeCount{ 0 };
+    std::atomic<uint64_t> costMismatchCount{ 0 };
+    std::atomic<uint64_t> routeMismatchCount{ 0 };
+#endif
+
     uint32_t subtractMovePoints( const uint32_t movePoints, const uint32_t subtractedMovePoints, const uint32_t maxMovePoints )
     {
         // We do not perform pathfinding for a real hero on the map, this is no-op
@@ -341,6 +381,78 @@ namespace
     }
 }
 
+void WorldNodeQueue::push( const int nodeIdx, const uint32_t cost )
+{
+    if ( _isInsertionOrder ) {
+        _insertionOrderEntries.emplace_back( nodeIdx, cost );
+        ++_size;
+        return;
+    }
+
+    const uint64_t key = ( static_cast<uint64_t>( cost ) << 32 ) | _sequence;
+    assert( key > _lastKey || ( _size == 0 && key == _lastKey ) );
+
+    ++_sequence;
+    // The sequence number must not overflow, otherwise the order of extraction of tiles with the same cost will be broken
+    assert( _sequence != 0 );
+
+    _buckets[getBucketIndex( key, _lastKey )].push_back( { key, nodeIdx } );
+    ++_size;
+}
+
+std::pair<int, uint32_t> WorldNodeQueue::pop()
+{
+    assert( _size > 0 );
+
+    if ( _isInsertionOrder ) {
+        --_size;
+        return _insertionOrderEntries[_insertionOrderFront++];
+    }
+
+    if ( _buckets[0].empty() ) {
+        size_t bucketIdx = 1;
+        while ( _buckets[bucketIdx].empty() ) {
+            ++bucketIdx;
+
+            assert( bucketIdx < _buckets.size() );
+        }
+
+        std::vector<Entry> & bucket = _buckets[bucketIdx];
+
+        _lastKey = std::min_element( bucket.begin(), bucket.end(), []( const Entry & left, const Entry & right ) { return left.key < right.key; } )->key;
+
+        // All entries from this bucket are moved to buckets with lower indexes
+        for ( const Entry & entry : bucket ) {
+            _buckets[getBucketIndex( entry.key, _lastKey )].push_back( entry );
+        }
+
+        bucket.clear();
+    }
+
+    // Since all keys are unique, the bucket 0 contains exactly one entry
+    assert( _buckets[0].size() == 1 );
+
+    const Entry entry = _buckets[0].back();
+    _buckets[0].pop_back();
+    --_size;
+
+    return { entry.nodeIdx, static_cast<uint32_t>( entry.key >> 32 ) };
+}
+
+void WorldNodeQueue::clear()
+{
+    for ( std::vector<Entry> & bucket : _buckets ) {
+        bucket.clear();
+    }
+
+    _lastKey = 0;
+    _sequence = 0;
+    _size = 0;
+
+    _insertionOrderEntries.clear();
+    _insertionOrderFront = 0;
+}
+
 uint32_t WorldPathfinder::getDistance( int targetIndex ) const
 {
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
@@ -348,6 +460,12 @@ uint32_t WorldPathfinder::getDistance( int targetIndex ) const
     return _cache[targetIndex]._cost;
 }
 
+bool WorldPathfinder::isPenaltyPathDependent() const
+{
+    // The "last move" logic uses remaining movement points of the hero on the source tile.
+    return getMaxMovePoints( false ) > 0 || getMaxMovePoints( true ) > 0;
+}
+
 uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, const int direction ) const
 {
     const Maps::Tile & fromTile = world.getTile( from );
@@ -417,15 +535,100 @@ void WorldPathfinder::processWorldMap()
 
     _cache[_pathStart].update( -1, 0, _remainingMovePoints );
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    _nodesToExplore.clear();
+    _nodesToExplore.push( _pathStart, 0 );
+
+    exploreNodes();
+}
+
+void WorldPathfinder::exploreNodes()
+{
+    _expandedNodesCount = 0;
+
+    // If tiles are processed in the order in which they are added, they are processed on every addition, even if their cost has changed since then.
+    const bool skipOutdatedNodes = !_nodesToExplore.isInsertionOrder();
+
+    while ( !_nodesToExplore.empty() ) {
+        const auto [nodeIdx, cost] = _nodesToExplore.pop();
+
+        // The cost of this node has changed since it was added to the queue, so either it has already been processed with a lower cost, or it
+        // has been reset as inaccessible. In both cases, there is nothing to do.
+        if ( skipOutdatedNodes && _cache[nodeIdx]._cost != cost ) {
+            continue;
+        }
+
+        ++_expandedNodesCount;
+
+        processCurrentNode( _nodesToExplore, nodeIdx );
+    }
+
+    DEBUG_LOG( DBG_GAME, DBG_TRACE, "start tile: " << _pathStart << ", expanded nodes: " << _expandedNodesCount )
+}
+
+void WorldPathfinder::evaluateWorldMap()
+{
+    const bool isInsertionOrder = isPenaltyPathDependent();
+
+    _nodesToExplore.setInsertionOrder( isInsertionOrder );
+    processWorldMap();
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+#if defined( WITH_DEBUG )
+    if ( !isExplorationVerificationEnabled ) {
+        return;
+    }
+
+    std::vector<WorldNode> result = _cache;
+    const uint32_t expandedNodesCount = _expandedNodesCount;
+
+    _nodesToExplore.setInsertionOrder( !isInsertionOrder );
+    processWorldMap();
+
+    uint64_t costMismatches = 0;
+    uint64_t routeMismatches = 0;
+
+    for ( size_t idx = 0; idx < _cache.size(); ++idx ) {
+        if ( result[idx]._cost != _cache[idx]._cost ) {
+            ++costMismatches;
+        }
+        else if ( result[idx]._from != _cache[idx]._from ) {
+            ++routeMismatches;
+        }
+    }
+
+    ++verifiedEvaluationCount;
+    verifiedNodeCount += _cache.size();
+    costMismatchCount += costMismatches;
+    routeMismatchCount += routeMismatches;
+
+    if ( costMismatches > 0 ) {
+        DEBUG_LOG( DBG_GAME, DBG_WARN,
+                   "start tile: " << _pathStart << ", tiles with a different cost: " << costMismatches << ", tiles with a different route: " << routeMismatches )
     }
+
+    _cache = std::move( result );
+    _expandedNodesCount = expandedNodesCount;
+#endif
+}
+
+#if defined( WITH_DEBUG )
+void WorldPathfinder::setExplorationVerification( const bool enable )
+{
+    isExplorationVerificationEnabled = enable;
 }
 
-void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+WorldPathfinder::ExplorationVerificationStats WorldPathfinder::getExplorationVerificationStats()
+{
+    ExplorationVerificationStats stats;
+    stats.evaluationCount = verifiedEvaluationCount;
+    stats.nodeCount = verifiedNodeCount;
+    stats.costMismatchCount = costMismatchCount;
+    stats.routeMismatchCount = routeMismatchCount;
+
+    return stats;
+}
+#endif
+
+void WorldPathfinder::checkAdjacentNodes( WorldNodeQueue & nodesToExplore, const int currentNodeIdx )
 {
     const Directions & directions = Direction::All();
     const WorldNode & currentNode = _cache[currentNodeIdx];
@@ -449,7 +652,7 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, con
         if ( newNode._from == -1 || newNode._cost > movementCost ) {
             newNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
 
-            nodesToExplore.push_back( newIndex );
+            nodesToExplore.push( newIndex, movementCost );
         }
     }
 }
@@ -475,7 +678,7 @@ void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
 
-        processWorldMap();
+        evaluateWorldMap();
     }
 }
 
@@ -516,7 +719,7 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     return path;
 }
 
-void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void PlayerWorldPathfinder::processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
     const WorldNode & currentNode = _cache[currentNodeIdx];
@@ -660,7 +863,7 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
 
-        processWorldMap();
+        evaluateWorldMap();
     }
 }
 
@@ -676,7 +879,7 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const int color, co
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
 
-        processWorldMap();
+        evaluateWorldMap();
     }
 }
 
@@ -712,10 +915,10 @@ void AIWorldPathfinder::processWorldMap()
 
     _cache[_pathStart].update( -1, 0, _remainingMovePoints );
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    _nodesToExplore.clear();
+    _nodesToExplore.push( _pathStart, 0 );
 
-    const auto processTownPortal = [this, &nodesToExplore]( const Spell & spell, const int32_t castleIndex ) {
+    const auto processTownPortal = [this]( const Spell & spell, const int32_t castleIndex ) {
         assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < _cache.size() );
         assert( castleIndex != _pathStart && _cache[castleIndex]._from == -1 );
 
@@ -724,7 +927,7 @@ void AIWorldPathfinder::processWorldMap()
 
         _cache[castleIndex].update( _pathStart, cost, remaining );
 
-        nodesToExplore.push_back( castleIndex );
+        _nodesToExplore.push( castleIndex, cost );
     };
 
     if ( _townGateCastleIndex != -1 ) {
@@ -739,9 +942,7 @@ void AIWorldPathfinder::processWorldMap()
         processTownPortal( Spell::TOWNPORTAL, idx );
     }
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
-    }
+    exploreNodes();
 }
 
 bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction ) const
@@ -749,7 +950,7 @@ bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction )
     return isMovementAllowedForColor( from, direction, _color, false, _isSummonBoatSpellAvailable );
 }
 
-void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void AIWorldPathfinder::processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
     WorldNode & currentNode = _cache[currentNodeIdx];
@@ -814,7 +1015,7 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
         if ( teleportNode._from == -1 || teleportNode._cost > currentNode._cost ) {
             teleportNode.update( currentNodeIdx, currentNode._cost, currentNode._remainingMovePoints );
 
-            nodesToExplore.push_back( teleportIdx );
+            nodesToExplore.push( teleportIdx, currentNode._cost );
         }
     }
 }
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <optional>
@@ -71,6 +73,72 @@ struct WorldNode final
     }
 };
 
+// Monotone priority queue (radix heap) of map tiles ordered by their movement cost. Tiles with the same cost are extracted in
+// the order in which they were added. Costs of added tiles must not be less than the cost of the last extracted tile.
+//
+// Before this queue was introduced, tiles were processed in the order in which they were added, and a tile was processed again
+// every time its cost improved. Both approaches give the same cost for every tile as long as the penalty of a move depends only
+// on the pair of tiles. However, the penalty may also depend on the path to the source tile: the "last move" rule uses remaining
+// movement points of the hero, and the AI adds a penalty for the change of direction based on the previous tile of the path.
+// Among several paths to a tile with the same cost the first found one is kept in both cases, but the order of finding them
+// differs, so the previous tile, remaining movement points and, as a consequence, costs of further tiles can differ. Therefore
+// the queue can also extract tiles in the order in which they were added, which is used for such penalties.
+class WorldNodeQueue
+{
+public:
+    WorldNodeQueue() = default;
+    WorldNodeQueue( const WorldNodeQueue & ) = delete;
+
+    ~WorldNodeQueue() = default;
+
+    WorldNodeQueue & operator=( const WorldNodeQueue & ) = delete;
+
+    void push( const int nodeIdx, const uint32_t cost );
+
+    // Extracts the tile with the lowest cost. Returns a pair consisting of the tile index and the cost with which it was added.
+    std::pair<int, uint32_t> pop();
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    void clear();
+
+    // If enabled, tiles are extracted in the order in which they were added regardless of their cost.
+    void setInsertionOrder( const bool isInsertionOrder )
+    {
+        clear();
+
+        _isInsertionOrder = isInsertionOrder;
+    }
+
+    bool isInsertionOrder() const
+    {
+        return _isInsertionOrder;
+    }
+
+private:
+    struct Entry
+    {
+        // The cost is stored in the upper 32 bits and the sequence number of the addition in the lower 32 bits
+        uint64_t key{ 0 };
+        int nodeIdx{ -1 };
+    };
+
+    // Bucket 0 contains entries with a key equal to the last extracted key, bucket N contains entries whose key differs from
+    // the last extracted key in the N-th bit (counting from 1) and in no higher bits.
+    std::array<std::vector<Entry>, 65> _buckets;
+
+    uint64_t _lastKey{ 0 };
+    uint32_t _sequence{ 0 };
+    size_t _size{ 0 };
+
+    std::vector<std::pair<int, uint32_t>> _insertionOrderEntries;
+    size_t _insertionOrderFront{ 0 };
+    bool _isInsertionOrder{ false };
+};
+
 // Abstract class that provides basic functionality for navigating the World Map
 class WorldPathfinder
 {
@@ -86,17 +154,53 @@ public:
 
     uint32_t getDistance( int targetIndex ) const;
 
+    // Returns the number of nodes processed during the last re-evaluation of the pathfinder cache
+    uint32_t getExpandedNodesCount() const
+    {
+        return _expandedNodesCount;
+    }
+
+#if defined( WITH_DEBUG )
+    struct ExplorationVerificationStats
+    {
+        uint64_t evaluationCount{ 0 };
+        uint64_t nodeCount{ 0 };
+        // The number of tiles which got a different cost.
+        uint64_t costMismatchCount{ 0 };
+        // The number of tiles which got the same cost, but a different previous tile of the path.
+        uint64_t routeMismatchCount{ 0 };
+    };
+
+    // If enabled, every re-evaluation of the pathfinder cache is repeated by processing tiles in the other order (see WorldNodeQueue)
+    // and the results are compared. This is very slow and is used only to find out how much the results depend on the order, for
+    // example, by running the headless AI game runner over real maps.
+    static void setExplorationVerification( const bool enable );
+
+    static ExplorationVerificationStats getExplorationVerificationStats();
+#endif
+
 protected:
-    void checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx );
+    void checkAdjacentNodes( WorldNodeQueue & nodesToExplore, const int currentNodeIdx );
+
+    // Processes the queued nodes in the order of increasing movement cost until there are no more nodes to explore
+    void exploreNodes();
+
+    // Re-evaluates the pathfinder cache.
+    void evaluateWorldMap();
 
     virtual void processWorldMap();
 
+    // Returns true if the movement penalty might depend on the path to the source tile and not only on the pair of tiles. In this case
+    // tiles are processed in the order in which they are added, otherwise they are processed in the order of increasing movement cost.
+    // The default implementation takes into account the "last move" logic and can be overridden by a derived class.
+    virtual bool isPenaltyPathDependent() const;
+
     // Checks whether moving from the source tile in the specified direction is allowed. The default implementation
     // can be overridden by a derived class.
     virtual bool isMovementAllowed( const int from, const int direction ) const;
 
     // Defines the pathfinding rules and should be implemented by a derived class.
-    virtual void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) = 0;
+    virtual void processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx ) = 0;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water. Should be implemented by a derived class.
@@ -112,6 +216,10 @@ protected:
     std::vector<WorldNode> _cache;
     std::vector<int> _mapOffset;
 
+    // The queue is kept between re-evaluations to avoid memory reallocations
+    WorldNodeQueue _nodesToExplore;
+    uint32_t _expandedNodesCount{ 0 };
+
     // The hero properties used by the pathfinder are cached here not just for optimization, but also because some
     // of them may change even if the position of the hero does not change, so it should be possible to compare the
     // old values with the new ones to determine whether the pathfinder cache needs to be recalculated.
@@ -141,7 +249,7 @@ public:
 
 private:
     // Follows regular passability rules (for the human player)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points. This class is not intended for planning paths passing both on
     // land and on water at the same time, so the maximum number of movement points corresponding to the type of
@@ -230,7 +338,7 @@ private:
     bool isMovementAllowed( const int from, const int direction ) const override;
 
     // Follows custom passability rules (for the AI)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( WorldNodeQueue & nodesToExplore, const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water
@@ -242,6 +350,13 @@ private:
     // this hero and it should also have a valid information about the hero's remaining movement points.
     uint32_t getMovementPenalty( const int from, const int to, const int direction ) const override;
 
+    // Movement penalties of AI-controlled heroes always depend on the previous tile of the path when moving through objects, and
+    // the use of teleports depends on the tile from which the teleport was reached.
+    bool isPenaltyPathDependent() const override
+    {
+        return true;
+    }
+
     // The hero properties used by the pathfinder are cached here not just for optimization, but also because some
     // of them may change even if the position of the hero does not change, so it should be possible to compare the
     // old values with the new ones to determine whether the pathfinder cache needs to be recalculated.
@@ -24,6 +24,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <set>
 #include <utility>
 #include <vector>
@@ -34,6 +35,7 @@
 #include "maps_tiles.h"
 #include "math_base.h"
 #include "mp2.h"
+#include "thread.h"
 #include "world.h" // IWYU pragma: associated
 
 namespace
@@ -94,12 +96,33 @@ namespace
         return true;
     }
 
+    size_t GetRowStripCount( const int height )
+    {
+        return std::max<size_t>( std::min<size_t>( MultiThreading::getMaxParallelThreads(), static_cast<size_t>( height ) ), 1 );
+    }
+
+    // Splits the map into GetRowStripCount() strips of rows and calls 'func' for every strip in parallel. The arguments of 'func'
+    // are the index of a strip and the range of its rows [firstRow, lastRow).
+    void ProcessRowStrips( const int height, const std::function<void( const size_t, const int, const int )> & func )
+    {
+        const size_t stripCount = GetRowStripCount( height );
+
+        const auto processStrip = [height, stripCount, &func]( const size_t stripIdx, const uint32_t /* threadIdx */ ) {
+            const int firstRow = static_cast<int>( static_cast<size_t>( height ) * stripIdx / stripCount );
+            const int lastRow = static_cast<int>( static_cast<size_t>( height ) * ( stripIdx + 1 ) / stripCount );
+
+            func( stripIdx, firstRow, lastRow );
+        };
+
+        MultiThreading::parallelFor( stripCount, static_cast<uint32_t>( stripCount ), processStrip );
+    }
+
     void CheckAdjacentTiles( std::vector<MapRegionNode> & rawData, MapRegion & region, uint32_t rawDataWidth, const std::vector<int> & offsets )
     {
-        const int nodeIndex = region._nodes[region._lastProcessedNode].index;
+        const int nodeIndex = ConvertExtendedIndex( region._nodes[region._lastProcessedNode].index, rawDataWidth );
 
         for ( uint8_t direction = 0; direction < 8; ++direction ) {
-            const int newIndex = ConvertExtendedIndex( nodeIndex, rawDataWidth ) + offsets[direction];
+            const int newIndex = nodeIndex + offsets[direction];
             MapRegionNode & newTile = rawData[newIndex];
             if ( newTile.passable & GetDirectionBitmask( direction, true ) && newTile.isWater == region._isWater ) {
                 if ( newTile.type == REGION_NODE_OPEN ) {
@@ -182,9 +205,6 @@ void World::ComputeStaticAnalysis()
     const uint32_t extraRegionSize = 18;
     const uint32_t emptyLineFrequency = 7;
 
-    // Reset the region information for all tiles
-    std::for_each( vec_tiles.begin(), vec_tiles.end(), []( Maps::Tile & tile ) { tile.UpdateRegion( REGION_NODE_BLOCKED ); } );
-
     // Step 1. Split map into terrain, water and ground points
     // Initialize the obstacles vector
     TileDataVector obstacles[4];
@@ -202,36 +222,70 @@ void World::ComputeStaticAnalysis()
         obstacles[3].emplace_back( y, 0 ); // ground, rows
     }
 
+    // Tiles are processed in parallel by strips of rows. Every row belongs to a single strip, while counters of columns and of the whole map
+    // are collected for every strip separately and summed up afterwards.
+    struct StripStatistics
+    {
+        std::vector<int> waterColumnObstacles;
+        std::vector<int> groundColumnObstacles;
+        int obstacleCount{ 0 };
+        int waterCount{ 0 };
+        uint32_t terrainPenalty{ 0 };
+    };
+
+    std::vector<StripStatistics> stripStatistics( GetRowStripCount( height ) );
+
+    // Find the terrain
+    ProcessRowStrips( height, [this, &obstacles, &stripStatistics]( const size_t stripIdx, const int firstRow, const int lastRow ) {
+        StripStatistics & statistics = stripStatistics[stripIdx];
+        statistics.waterColumnObstacles.resize( width, 0 );
+        statistics.groundColumnObstacles.resize( width, 0 );
+
+        for ( int y = firstRow; y < lastRow; ++y ) {
+            const int rowIndex = y * width;
+            for ( int x = 0; x < width; ++x ) {
+                const int index = rowIndex + x;
+                Maps::Tile & tile = vec_tiles[index];
+
+                // Reset the region information for all tiles
+                tile.UpdateRegion( REGION_NODE_BLOCKED );
+
+                // If tile is blocked (mountain, trees, etc) then it's applied to both
+                if ( tile.GetPassable() == 0 ) {
+                    ++statistics.obstacleCount;
+                    ++statistics.waterColumnObstacles[x];
+                    ++obstacles[1][y].second;
+                    ++statistics.groundColumnObstacles[x];
+                    ++obstacles[3][y].second;
+                }
+                else if ( tile.isWater() ) {
+                    ++statistics.waterCount;
+                    // if it's water then ground tiles consider it an obstacle
+                    ++statistics.groundColumnObstacles[x];
+                    ++obstacles[3][y].second;
+                }
+                else {
+                    statistics.terrainPenalty += Maps::Ground::GetPenalty( tile, 0 );
+                    // else then ground is an obstacle for water navigation
+                    ++statistics.waterColumnObstacles[x];
+                    ++obstacles[1][y].second;
+                }
+            }
+        }
+    } );
+
     int obstacleCount = 0;
     int waterCount = 0;
     uint32_t terrainPenalty = 0;
 
-    // Find the terrain
-    for ( int y = 0; y < height; ++y ) {
-        const int rowIndex = y * width;
+    for ( const StripStatistics & statistics : stripStatistics ) {
+        obstacleCount += statistics.obstacleCount;
+        waterCount += statistics.waterCount;
+        terrainPenalty += statistics.terrainPenalty;
+
         for ( int x = 0; x < width; ++x ) {
-            const int index = rowIndex + x;
-            const Maps::Tile & tile = vec_tiles[index];
-            // If tile is blocked (mountain, trees, etc) then it's applied to both
-            if ( tile.GetPassable() == 0 ) {
-                ++obstacleCount;
-                ++obstacles[0][x].second;
-                ++obstacles[1][y].second;
-                ++obstacles[2][x].second;
-                ++obstacles[3][y].second;
-            }
-            else if ( tile.isWater() ) {
-                ++waterCount;
-                // if it's water then ground tiles consider it an obstacle
-                ++obstacles[2][x].second;
-                ++obstacles[3][y].second;
-            }
-            else {
-                terrainPenalty += Maps::Ground::GetPenalty( tile, 0 );
-                // else then ground is an obstacle for water navigation
-                ++obstacles[0][x].second;
-                ++obstacles[1][y].second;
-            }
+            obstacles[0][x].second += statistics.waterColumnObstacles[x];
+            obstacles[2][x].second += statistics.groundColumnObstacles[x];
         }
     }
 
@@ -317,24 +371,26 @@ void World::ComputeStaticAnalysis()
     // Step 5. Initialize extended (by 2 tiles) map data used for region growing based on actual Maps::Tiles
     const uint32_t extendedWidth = width + 2;
     std::vector<MapRegionNode> data( extendedWidth * ( height + 2 ) );
-    for ( int y = 0; y < height; ++y ) {
-        const int rowIndex = y * width;
-        for ( int x = 0; x < width; ++x ) {
-            const int index = rowIndex + x;
-            const Maps::Tile & tile = vec_tiles[index];
-            MapRegionNode & node = data[ConvertExtendedIndex( index, extendedWidth )];
-
-            node.index = index;
-            node.passable = tile.GetPassable();
-            node.isWater = tile.isWater();
-
-            const MP2::MapObjectType objectType = tile.getMainObjectType();
-            node.mapObject = MP2::isInGameActionObject( objectType, node.isWater ) ? objectType : 0;
-            if ( node.passable != 0 ) {
-                node.type = REGION_NODE_OPEN;
+    ProcessRowStrips( height, [this, &data, extendedWidth]( const size_t /* stripIdx */, const int firstRow, const int lastRow ) {
+        for ( int y = firstRow; y < lastRow; ++y ) {
+            const int rowIndex = y * width;
+            for ( int x = 0; x < width; ++x ) {
+                const int index = rowIndex + x;
+                const Maps::Tile & tile = vec_tiles[index];
+                MapRegionNode & node = data[ConvertExtendedIndex( index, extendedWidth )];
+
+                node.index = index;
+                node.passable = tile.GetPassable();
+                node.isWater = tile.isWater();
+
+                const MP2::MapObjectType objectType = tile.getMainObjectType();
+                node.mapObject = MP2::isInGameActionObject( objectType, node.isWater ) ? objectType : 0;
+                if ( node.passable != 0 ) {
+                    node.type = REGION_NODE_OPEN;
+                }
             }
         }
-    }
+    } );
 
     // Step 6. Initialize regions
     size_t averageRegionSize = ( static_cast<size_t>( width ) * height * 2 ) / regionCenters.size();
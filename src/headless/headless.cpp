@@ -0,0 +1,343 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+// This is a runner of AI-only games which does not use video, audio and input subsystems. It is used to simulate
+// a large number of turns on different maps to find performance regressions and crashes in the AI and battle code.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "agg.h"
+#include "ai_planner.h"
+#include "army.h"
+#include "color.h"
+#include "core.h"
+#include "game.h"
+#include "game_mode.h"
+#include "game_over.h"
+#include "game_turn_profiler.h"
+#include "h2d.h"
+#include "image_palette.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "maps_fileinfo.h"
+#include "players.h"
+#include "rand.h"
+#include "settings.h"
+#include "timing.h"
+#include "world.h"
+#include "world_pathfinding.h"
+
+namespace
+{
+    struct Options
+    {
+        std::string mapFilePath;
+        uint32_t turnCount{ 100 };
+        uint32_t seed{ 0 };
+        // The number of threads used by AI to evaluate targets for its heroes, see Settings::getAIWorkerThreads().
+        uint32_t aiWorkerThreads{ 1 };
+        bool verifyPathfinder{ false };
+    };
+
+    struct TurnStats
+    {
+        std::string date;
+        uint64_t totalTimeUs{ 0 };
+        uint64_t kingdomTimeUs{ 0 };
+        uint64_t heroesTimeUs{ 0 };
+        uint64_t battleTimeUs{ 0 };
+        uint64_t strengthCacheHitCount{ 0 };
+        uint64_t strengthCalculationCount{ 0 };
+    };
+
+    void printUsage( const char * programName )
+    {
+        std::cerr << "Usage: " << programName << " <map file> [--turns <number of turns>] [--seed <random seed>] [--ai-threads <number of threads>]"
+#if defined( WITH_DEBUG )
+                  << " [--verify-pathfinder]"
+#endif
+                  << std::endl;
+    }
+
+    bool parseUnsignedNumber( const char * value, uint32_t & result )
+    {
+        try {
+            size_t length = 0;
+            const unsigned long number = std::stoul( value, &length );
+
+            if ( value[length] != '\0' || number > UINT32_MAX ) {
+                return false;
+            }
+
+            result = static_cast<uint32_t>( number );
+        }
+        catch ( const std::exception & ) {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool parseOptions( const int argc, char ** argv, Options & options )
+    {
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string argument( argv[i] );
+
+#if defined( WITH_DEBUG )
+            if ( argument == "--verify-pathfinder" ) {
+                options.verifyPathfinder = true;
+                continue;
+            }
+#endif
+
+            if ( argument == "--turns" || argument == "--seed" || argument == "--ai-threads" ) {
+                if ( i + 1 >= argc ) {
+                    return false;
+                }
+
+                uint32_t & value = ( argument == "--turns" ) ? options.turnCount : ( argument == "--seed" ) ? options.seed : options.aiWorkerThreads;
+                if ( !parseUnsignedNumber( argv[++i], value ) ) {
+                    return false;
+                }
+            }
+            else if ( options.mapFilePath.empty() ) {
+                options.mapFilePath = argument;
+            }
+            else {
+                return false;
+            }
+        }
+
+        return !options.mapFilePath.empty() && options.turnCount > 0;
+    }
+
+    bool loadMap( const std::string & mapFilePath )
+    {
+        Maps::FileInfo mapInfo;
+
+        const bool isResurrectionMap = !mapInfo.readMP2Map( mapFilePath, false );
+        if ( isResurrectionMap && !mapInfo.readResurrectionMap( mapFilePath, false ) ) {
+            ERROR_LOG( "Failed to read the map file " << mapFilePath )
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+
+        conf.SetGameType( Game::TYPE_STANDARD );
+        conf.setCurrentMapInfo( mapInfo );
+
+        // All players, including the ones which are available only for humans, are controlled by AI.
+        for ( Player * player : conf.GetPlayers() ) {
+            player->SetControl( CONTROL_AI );
+        }
+
+        conf.GetPlayers().SetStartGame();
+
+        const bool isLoaded = isResurrectionMap ? world.loadResurrectionMap( mapInfo.filename )
+                                                : world.LoadMapMP2( mapInfo.filename, ( mapInfo.version == GameVersion::SUCCESSION_WARS ) );
+        if ( !isLoaded ) {
+            ERROR_LOG( "Failed to load the map file " << mapFilePath )
+            return false;
+        }
+
+        GameOver::Result::Get().Reset();
+
+        return true;
+    }
+
+    // Simulates one day of the game the same way as the turn loop of Interface::AdventureMap::StartGame() does it for AI players.
+    // Returns fheroes2::GameMode::CANCEL if the game goes on, otherwise the game is over.
+    fheroes2::GameMode simulateTurn( const std::vector<Player *> & sortedPlayers )
+    {
+        Settings & conf = Settings::Get();
+        GameOver::Result & gameResult = GameOver::Result::Get();
+
+        world.NewDay();
+
+        // Check if the game is over at the beginning of a new day
+        fheroes2::GameMode result = gameResult.checkGameOver();
+        if ( result != fheroes2::GameMode::CANCEL ) {
+            return result;
+        }
+
+        for ( const Player * player : sortedPlayers ) {
+            const int playerColor = player->GetColor();
+            Kingdom & kingdom = world.GetKingdom( playerColor );
+
+            if ( !kingdom.isPlay() ) {
+                continue;
+            }
+
+            conf.SetCurrentColor( playerColor );
+
+            kingdom.ActionNewDayResourceUpdate( nullptr );
+            kingdom.ActionBeforeTurn();
+
+            result = AI::Planner::Get().KingdomTurn( kingdom );
+            if ( result != fheroes2::GameMode::END_TURN ) {
+                break;
+            }
+
+            // Check if the game is over after each player's turn
+            result = gameResult.checkGameOver();
+            if ( result != fheroes2::GameMode::CANCEL ) {
+                break;
+            }
+        }
+
+        conf.SetCurrentColor( Color::NONE );
+
+        return result;
+    }
+
+    void printStats( const std::vector<TurnStats> & stats )
+    {
+        const auto toMs = []( const uint64_t timeUs ) { return static_cast<double>( timeUs ) / 1000; };
+
+        std::cout << "turn,date,total ms,kingdom ms,heroes ms,battle ms,strength cache hits,strength calculations" << std::endl;
+        std::cout << std::fixed << std::setprecision( 3 );
+
+        TurnStats total;
+
+        for ( size_t i = 0; i < stats.size(); ++i ) {
+            const TurnStats & turn = stats[i];
+
+            std::cout << i + 1 << ",\"" << turn.date << "\"," << toMs( turn.totalTimeUs ) << ',' << toMs( turn.kingdomTimeUs ) << ',' << toMs( turn.heroesTimeUs )
+                      << ',' << toMs( turn.battleTimeUs ) << ',' << turn.strengthCacheHitCount << ',' << turn.strengthCalculationCount << std::endl;
+
+            total.totalTimeUs += turn.totalTimeUs;
+            total.kingdomTimeUs += turn.kingdomTimeUs;
+            total.heroesTimeUs += turn.heroesTimeUs;
+            total.battleTimeUs += turn.battleTimeUs;
+            total.strengthCacheHitCount += turn.strengthCacheHitCount;
+            total.strengthCalculationCount += turn.strengthCalculationCount;
+        }
+
+        std::cout << "total,," << toMs( total.totalTimeUs ) << ',' << toMs( total.kingdomTimeUs ) << ',' << toMs( total.heroesTimeUs ) << ','
+                  << toMs( total.battleTimeUs ) << ',' << total.strengthCacheHitCount << ',' << total.strengthCalculationCount << std::endl;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    Options options;
+    if ( !parseOptions( argc, argv, options ) ) {
+        printUsage( argv[0] );
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const fheroes2::HardwareInitializer hardwareInitializer;
+        Logging::InitLog();
+
+        Settings & conf = Settings::Get();
+        conf.SetProgramPath( argv[0] );
+
+        // AI hero movements are not rendered. Battles between AI players are always resolved without the battle interface.
+        conf.SetAIMoveSpeed( 0 );
+        conf.setAIWorkerThreads( static_cast<int>( std::min( options.aiWorkerThreads, 64U ) ) );
+
+        Game::setHeadlessMode( true );
+
+        // No SDL subsystem is initialized: there is no window, no sound and no input.
+        const fheroes2::CoreInitializer coreInitializer( {} );
+
+        const AGG::AGGInitializer aggInitializer;
+        const fheroes2::h2d::H2DInitializer h2dInitializer;
+
+        fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ) );
+
+        Game::Init();
+
+#if defined( WITH_DEBUG )
+        WorldPathfinder::setExplorationVerification( options.verifyPathfinder );
+#endif
+
+        // The same seed gives the same sequence of games on the same map.
+        Rand::CurrentThreadRandomDevice().seed( options.seed );
+
+        if ( !loadMap( options.mapFilePath ) ) {
+            return EXIT_FAILURE;
+        }
+
+        const std::vector<Player *> sortedPlayers = conf.GetPlayers().getPlayersInTurnOrder();
+
+        for ( const Player * player : sortedPlayers ) {
+            world.ClearFog( player->GetColor() );
+        }
+
+        std::vector<TurnStats> stats;
+        stats.reserve( options.turnCount );
+
+        for ( uint32_t turn = 0; turn < options.turnCount; ++turn ) {
+            Game::TurnProfiler::reset();
+
+            const uint64_t strengthCacheHitCount = Army::getStrengthCacheHitCount();
+            const uint64_t strengthCalculationCount = Army::getStrengthCalculationCount();
+
+            const fheroes2::Time turnTimer;
+
+            const bool isGameOver = ( simulateTurn( sortedPlayers ) != fheroes2::GameMode::CANCEL );
+
+            TurnStats & turnStats = stats.emplace_back();
+            turnStats.date = world.DateString();
+            turnStats.totalTimeUs = static_cast<uint64_t>( turnTimer.getS() * 1000000 );
+            turnStats.kingdomTimeUs = Game::TurnProfiler::getPhaseTimeUs( Game::TurnProfiler::Phase::KINGDOM );
+            turnStats.heroesTimeUs = Game::TurnProfiler::getPhaseTimeUs( Game::TurnProfiler::Phase::HEROES );
+            turnStats.battleTimeUs = Game::TurnProfiler::getPhaseTimeUs( Game::TurnProfiler::Phase::BATTLE );
+            turnStats.strengthCacheHitCount = Army::getStrengthCacheHitCount() - strengthCacheHitCount;
+            turnStats.strengthCalculationCount = Army::getStrengthCalculationCount() - strengthCalculationCount;
+
+            if ( isGameOver ) {
+                break;
+            }
+        }
+
+        printStats( stats );
+
+#if defined( WITH_DEBUG )
+        if ( options.verifyPathfinder ) {
+            const WorldPathfinder::ExplorationVerificationStats verificationStats = WorldPathfinder::getExplorationVerificationStats();
+
+            std::cout << "pathfinder evaluations: " << verificationStats.evaluationCount << ", tiles: " << verificationStats.nodeCount
+                      << ", tiles with a different cost: " << verificationStats.costMismatchCount
+                      << ", tiles with a different route: " << verificationStats.routeMismatchCount << std::endl;
+        }
+#endif
+    }
+    catch ( const std::exception & ex ) {
+        ERROR_LOG( "Exception '" << ex.what() << "' occurred during application runtime." )
+        return EXIT_FAILURE;
+    }
+    catch ( ... ) {
+        ERROR_LOG( "An unknown exception occurred during application runtime." )
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}